@@ -0,0 +1,105 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/AtomicFraction.hpp"
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+using namespace ariel;
+
+TEST_SUITE("Atomic fractions")
+{
+    TEST_CASE("Load, store, exchange and negative values round trip")
+    {
+        static_assert(AtomicFraction::is_always_lock_free);
+        AtomicFraction value;
+        CHECK(value.load().getNumerator() == 0);
+        CHECK(value.load().getDenominator() == 1);
+        value.store(Fraction(-6, 8));
+        CHECK(value.load().getNumerator() == -3);
+        CHECK(value.load().getDenominator() == 4);
+        int min_int = std::numeric_limits<int>::min();
+        Fraction old = value.exchange(Fraction(min_int, 1));
+        CHECK(old.getNumerator() == -3);
+        CHECK(value.load().getNumerator() == min_int);
+    }
+
+    TEST_CASE("Fetch operations return the previous value and reduce")
+    {
+        AtomicFraction value(Fraction(1, 6));
+        Fraction previous = value.fetch_add(Fraction(1, 3));
+        CHECK(previous.getNumerator() == 1);
+        CHECK(previous.getDenominator() == 6);
+        CHECK(value.load().getNumerator() == 1);
+        CHECK(value.load().getDenominator() == 2);
+        value.fetch_sub(Fraction(1, 2));
+        CHECK(value.load().getNumerator() == 0);
+        CHECK(value.load().getDenominator() == 1);
+        // 0 - INT_MIN does not fit even though the delta itself does
+        CHECK_THROWS_AS(value.fetch_sub(Fraction(std::numeric_limits<int>::min(), 1)), std::overflow_error);
+        value.fetch_sub(Fraction(std::numeric_limits<int>::min() + 1, 1));
+        CHECK(value.load().getNumerator() == std::numeric_limits<int>::max());
+    }
+
+    TEST_CASE("Compare exchange compares exactly")
+    {
+        AtomicFraction value(Fraction(1, 3));
+        // operator== rounds both to 0.333 and calls them equal
+        Fraction close(333, 1000);
+        CHECK(close == Fraction(1, 3));
+        Fraction expected = close;
+        CHECK_FALSE(value.compare_exchange_strong(expected, Fraction(1)));
+        CHECK(expected.getNumerator() == 1);
+        CHECK(expected.getDenominator() == 3);
+        CHECK(value.compare_exchange_strong(expected, Fraction(2)));
+        CHECK(value.load().getNumerator() == 2);
+        expected = Fraction(2);
+        while (!value.compare_exchange_weak(expected, Fraction(5, 7)))
+        {
+        }
+        CHECK(value.load().getDenominator() == 7);
+    }
+
+    TEST_CASE("Overflow is reported and leaves the value unchanged")
+    {
+        int max_int = std::numeric_limits<int>::max();
+        AtomicFraction value(Fraction(max_int, 1));
+        Fraction previous;
+        CHECK_FALSE(value.try_fetch_add(Fraction(1), previous));
+        CHECK(previous.getNumerator() == max_int);
+        CHECK(value.load().getNumerator() == max_int);
+        CHECK_THROWS_AS(value.fetch_add(Fraction(1)), std::overflow_error);
+        CHECK(value.load().getNumerator() == max_int);
+        CHECK(value.try_fetch_sub(Fraction(1), previous));
+        CHECK(value.load().getNumerator() == max_int - 1);
+
+        // the unreduced sum does not fit in int but the reduced one does
+        AtomicFraction half(Fraction(1, max_int - 1));
+        CHECK(half.try_fetch_add(Fraction(1, max_int - 1), previous));
+        CHECK(half.load().getNumerator() == 1);
+        CHECK(half.load().getDenominator() == (max_int - 1) / 2);
+    }
+
+    TEST_CASE("Concurrent additions are not lost")
+    {
+        AtomicFraction total;
+        const int perThread = 5000;
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < 4; ++thread)
+        {
+            threads.emplace_back([&total, thread]()
+                                 {
+                for (int i = 0; i < perThread; ++i)
+                {
+                    total.fetch_add(Fraction(1, thread % 2 == 0 ? 2 : 3));
+                } });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        // 2 threads add 5000/2 each and 2 threads add 5000/3 each
+        CHECK(total.load().getNumerator() == 25000);
+        CHECK(total.load().getDenominator() == 3);
+    }
+}
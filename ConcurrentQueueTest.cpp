@@ -0,0 +1,167 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/ConcurrentQueue.hpp"
+#include <atomic>
+#include <span>
+#include <thread>
+#include <vector>
+using namespace ariel;
+
+namespace
+{
+    /// push the integers 1..count from each producer in batches and pop them with the consumers,
+    /// returns the sum of the popped values and checks the order when there is one producer and one consumer
+    template <typename Queue>
+    long long transfer(Queue &queue, int producers, int consumers, int count, std::size_t batchSize)
+    {
+        std::atomic<long long> sum{0};
+        std::atomic<int> received{0};
+        std::atomic<bool> ordered{true};
+        int total = producers * count;
+        std::vector<std::thread> threads;
+        for (int producer = 0; producer < producers; ++producer)
+        {
+            threads.emplace_back([&queue, count, batchSize]()
+                                 {
+                std::vector<Fraction> batch;
+                int next = 1;
+                while (next <= count)
+                {
+                    batch.clear();
+                    for (std::size_t i = 0; i < batchSize && next <= count; ++i, ++next)
+                    {
+                        batch.emplace_back(next);
+                    }
+                    std::span<Fraction> rest(batch);
+                    while (!rest.empty())
+                    {
+                        rest = rest.subspan(queue.tryPushBatch(rest));
+                        std::this_thread::yield();
+                    }
+                } });
+        }
+        for (int consumer = 0; consumer < consumers; ++consumer)
+        {
+            threads.emplace_back([&]()
+                                 {
+                std::vector<Fraction> batch(batchSize);
+                int last = 0;
+                while (received.load() < total)
+                {
+                    std::size_t count = queue.tryPopBatch(batch);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        if (producers == 1 && consumers == 1 && batch[i].getNumerator() != last + 1)
+                        {
+                            ordered = false;
+                        }
+                        last = batch[i].getNumerator();
+                        sum += batch[i].getNumerator();
+                    }
+                    received += static_cast<int>(count);
+                    if (count == 0)
+                    {
+                        std::this_thread::yield();
+                    }
+                } });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        CHECK(ordered.load());
+        return sum.load();
+    }
+}
+
+TEST_SUITE("Concurrent queues")
+{
+    TEST_CASE("Queues keep order and report full and empty")
+    {
+        ConcurrentQueue<int> queue(3);
+        SpscQueue<int> ring(3);
+        CHECK(queue.capacity() == 4);
+        CHECK(ring.capacity() == 4);
+        int value = 0;
+        CHECK_FALSE(queue.tryPop(value));
+        CHECK_FALSE(ring.tryPop(value));
+        for (int i = 0; i < 4; ++i)
+        {
+            int pushed = i;
+            CHECK(queue.tryPush(pushed));
+            pushed = i;
+            CHECK(ring.tryPush(pushed));
+        }
+        int extra = 9;
+        CHECK_FALSE(queue.tryPush(extra));
+        CHECK_FALSE(ring.tryPush(extra));
+        CHECK(extra == 9);
+        for (int i = 0; i < 4; ++i)
+        {
+            CHECK(queue.tryPop(value));
+            CHECK(value == i);
+            CHECK(ring.tryPop(value));
+            CHECK(value == i);
+        }
+        CHECK_FALSE(queue.tryPop(value));
+        CHECK_FALSE(ring.tryPop(value));
+    }
+
+    TEST_CASE("Batches move a prefix that fits and wrap around")
+    {
+        ConcurrentQueue<Fraction> queue(8);
+        SpscQueue<Fraction> ring(8);
+        for (int round = 0; round < 5; ++round)
+        {
+            std::vector<Fraction> batch;
+            for (int i = 0; i < 6; ++i)
+            {
+                batch.emplace_back(round * 6 + i, 101);
+            }
+            // pushing moves the values out, so every push gets its own copy
+            std::vector<Fraction> copies[4] = {batch, batch, batch, batch};
+            CHECK(queue.tryPushBatch(copies[0]) == 6);
+            CHECK(ring.tryPushBatch(copies[1]) == 6);
+            CHECK(queue.tryPushBatch(copies[2]) == 2);
+            CHECK(ring.tryPushBatch(copies[3]) == 2);
+            std::vector<Fraction> popped(10);
+            CHECK(queue.tryPopBatch(popped) == 8);
+            CHECK(popped[5].getNumerator() == round * 6 + 5);
+            CHECK(popped[6].getNumerator() == round * 6);
+            CHECK(ring.tryPopBatch(popped) == 8);
+            CHECK(popped[7].getNumerator() == round * 6 + 1);
+            CHECK(queue.tryPopBatch(popped) == 0);
+            CHECK(ring.tryPopBatch(popped) == 0);
+        }
+    }
+
+    TEST_CASE("Empty batches return at once")
+    {
+        ConcurrentQueue<int> queue(4);
+        SpscQueue<int> ring(4);
+        CHECK(queue.tryPushBatch(std::span<int>{}) == 0);
+        CHECK(ring.tryPushBatch(std::span<int>{}) == 0);
+        CHECK(queue.tryPopBatch(std::span<int>{}) == 0);
+        CHECK(ring.tryPopBatch(std::span<int>{}) == 0);
+        int value = 7;
+        CHECK(queue.tryPush(value));
+        CHECK(queue.tryPopBatch(std::span<int>{}) == 0);
+        value = 0;
+        CHECK(queue.tryPop(value));
+        CHECK(value == 7);
+    }
+
+    TEST_CASE("Every value reaches exactly one consumer")
+    {
+        const int count = 20000;
+        long long expected = static_cast<long long>(count) * (count + 1) / 2;
+        SpscQueue<Fraction> ring(64);
+        CHECK(transfer(ring, 1, 1, count, 16) == expected);
+        ConcurrentQueue<Fraction> single(64);
+        CHECK(transfer(single, 1, 1, count, 7) == expected);
+        ConcurrentQueue<Fraction> queue(64);
+        CHECK(transfer(queue, 3, 3, count, 16) == 3 * expected);
+        ConcurrentQueue<Fraction> unbatched(16);
+        CHECK(transfer(unbatched, 2, 2, count, 1) == 2 * expected);
+    }
+}
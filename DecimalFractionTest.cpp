@@ -0,0 +1,77 @@
+#include "doctest.h"
+#include "sources/DecimalFraction.hpp"
+#include "sources/Fraction.hpp"
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+using namespace ariel;
+
+TEST_SUITE("Decimal fractions")
+{
+    TEST_CASE("Canonical form strips trailing zeros")
+    {
+        DecimalFraction value(12500, 3);
+        CHECK(value.getMantissa() == 125);
+        CHECK(value.getExponent() == 1);
+        CHECK(value == DecimalFraction(125, 1));
+        CHECK(DecimalFraction(0, 7).getExponent() == 0);
+        CHECK_THROWS_AS(DecimalFraction(1, 19), std::invalid_argument);
+    }
+
+    TEST_CASE("Float conversion matches the Fraction constructor")
+    {
+        DecimalFraction fromFloat(0.3333F);
+        CHECK(fromFloat == DecimalFraction(333, 3));
+        Fraction expected(0.3333);
+        Fraction converted = DecimalFraction(0.3333).toFraction();
+        CHECK(((converted.getNumerator() == expected.getNumerator()) && (converted.getDenominator() == expected.getDenominator())));
+        CHECK(DecimalFraction(-2.5) == DecimalFraction(-25, 1));
+    }
+
+    TEST_CASE("Exact conversion to and from Fraction")
+    {
+        DecimalFraction eighth(Fraction(-3, 8));
+        CHECK(eighth.toString() == "-0.375");
+        CHECK(DecimalFraction(Fraction(7, 1)).toString() == "7");
+        CHECK_THROWS_AS(DecimalFraction(Fraction(1, 3)), std::invalid_argument);
+        Fraction back = DecimalFraction(1234, 2).toFraction();
+        CHECK(((back.getNumerator() == 617) && (back.getDenominator() == 50)));
+    }
+
+    TEST_CASE("Integer only arithmetic")
+    {
+        DecimalFraction a(125, 2), b(5, 1);
+        CHECK((a + b) == DecimalFraction(175, 2));
+        CHECK((a - b) == DecimalFraction(75, 2));
+        CHECK((a * b) == DecimalFraction(625, 3));
+        CHECK((a / b) == DecimalFraction(25, 1));
+        CHECK((DecimalFraction(1) / DecimalFraction(8)) == DecimalFraction(125, 3));
+        CHECK_THROWS_AS(DecimalFraction(1) / DecimalFraction(3), std::domain_error);
+        CHECK_THROWS_AS(a / DecimalFraction(), std::runtime_error);
+        CHECK_THROWS_AS(DecimalFraction(1, 18) * DecimalFraction(1, 18), std::overflow_error);
+        std::int64_t max_mantissa = std::numeric_limits<std::int64_t>::max();
+        CHECK_THROWS_AS(DecimalFraction(max_mantissa, 0) / DecimalFraction(1LL << 36, 18), std::overflow_error);
+        CHECK(DecimalFraction(std::numeric_limits<std::int64_t>::min(), 0) < DecimalFraction(max_mantissa, 18));
+        CHECK(a > b);
+        CHECK(DecimalFraction(-1, 1) < DecimalFraction(-1, 2));
+    }
+
+    TEST_CASE("Parsing and printing")
+    {
+        CHECK(DecimalFraction::parse("-12.345") == DecimalFraction(-12345, 3));
+        CHECK(DecimalFraction::parse("+.5") == DecimalFraction(5, 1));
+        CHECK(DecimalFraction::parse("7.") == DecimalFraction(7));
+        CHECK(DecimalFraction::parse("-9223372036854775808") == DecimalFraction(INT64_MIN));
+        CHECK_FALSE(DecimalFraction::parse("9223372036854775808").has_value());
+        CHECK_FALSE(DecimalFraction::parse("1.2.3").has_value());
+        CHECK_FALSE(DecimalFraction::parse("-").has_value());
+        CHECK_FALSE(DecimalFraction::parse("1e5").has_value());
+
+        std::stringstream output;
+        output << DecimalFraction(-5, 3) << " " << DecimalFraction(INT64_MIN);
+        CHECK(output.str() == "-0.005 -9223372036854775808");
+        char small[3];
+        CHECK(DecimalFraction(12345).toChars(small, small + 3) == nullptr);
+    }
+}
@@ -0,0 +1,56 @@
+#include "doctest.h"
+#include "sources/FixedFraction.hpp"
+#include "sources/Fraction.hpp"
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+using namespace ariel;
+
+using Price = FixedFraction<1000>;
+using Probability = FixedFraction<256>;
+
+TEST_SUITE("Fixed denominator fractions")
+{
+    TEST_CASE("Exact conversion to and from Fraction")
+    {
+        Price price(Fraction(3, 8));
+        CHECK(price.getNumerator() == 375);
+        Fraction back = price.toFraction();
+        CHECK(((back.getNumerator() == 3) && (back.getDenominator() == 8)));
+        CHECK_THROWS_AS(Price(Fraction(1, 3)), std::invalid_argument);
+        CHECK(Price::rounded(Fraction(1, 3)).getNumerator() == 333);
+        CHECK(Price::rounded(Fraction(-2, 3)).getNumerator() == -667);
+        CHECK(Probability(Fraction(-1, 2)).getNumerator() == -128);
+    }
+
+    TEST_CASE("Add and subtract are exact")
+    {
+        Price a = Price::fromNumerator(1250), b = Price::fromNumerator(-2500);
+        CHECK((a + b).getNumerator() == -1250);
+        CHECK((a - b).getNumerator() == 3750);
+        Price big = Price::fromNumerator(std::numeric_limits<int>::max());
+        CHECK_THROWS_AS(big += a, std::overflow_error);
+        CHECK(big.getNumerator() == std::numeric_limits<int>::max());
+        CHECK(a < big);
+        CHECK(b <= a);
+        CHECK(a != b);
+    }
+
+    TEST_CASE("Multiply and divide round to the nearest multiple of 1/Den")
+    {
+        Price a(Fraction(3, 2)), b(Fraction(1, 4));
+        CHECK((a * b).toFraction() == Fraction(3, 8));
+        CHECK((Price::fromNumerator(1) * Price::fromNumerator(500)).getNumerator() == 1);
+        CHECK((Price::fromNumerator(1) * Price::fromNumerator(499)).getNumerator() == 0);
+        CHECK((a / b).getNumerator() == 6000);
+        CHECK((Price::fromNumerator(1000) / Price::fromNumerator(-3000)).getNumerator() == -333);
+        CHECK_THROWS_AS(a / Price(), std::runtime_error);
+    }
+
+    TEST_CASE("Printing uses the reduced value")
+    {
+        std::stringstream output;
+        output << Price::fromNumerator(250);
+        CHECK(output.str() == "1/4");
+    }
+}
@@ -0,0 +1,164 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionBinary.hpp"
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace ariel;
+
+namespace
+{
+    std::vector<Fraction> sampleColumn()
+    {
+        int max_int = std::numeric_limits<int>::max();
+        int min_int = std::numeric_limits<int>::min();
+        std::vector<Fraction> values{Fraction(), Fraction(1, 2), Fraction(-3, 4), Fraction(7), Fraction(-7),
+                                     Fraction(max_int, 1), Fraction(min_int, 1), Fraction(1, max_int), Fraction(min_int, max_int)};
+        for (int i = 0; i < 10000; ++i)
+        {
+            values.emplace_back(i * 37 - 150000, i % 113 + 1);
+        }
+        return values;
+    }
+
+    bool sameValues(const std::vector<Fraction> &left, const std::vector<Fraction> &right)
+    {
+        if (left.size() != right.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < left.size(); ++i)
+        {
+            if (left[i].getNumerator() != right[i].getNumerator() || left[i].getDenominator() != right[i].getDenominator())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void putLittleEndian(std::string &bytes, std::uint32_t value)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            bytes.push_back((char)((value >> shift) & 0xFFU));
+        }
+    }
+
+    /// @brief a well formed column holding the single record numerator / denominator, which need not be reduced
+    std::string singleRecordColumn(unsigned char numeratorZigzag, unsigned char denominator)
+    {
+        std::string bytes{'F', 'R', 'C', 'B', (char)FRACTION_BINARY_VERSION, 0, 0, 0};
+        std::vector<unsigned char> payload{(unsigned char)(numeratorZigzag << 1 | 1), denominator};
+        putLittleEndian(bytes, 1);
+        putLittleEndian(bytes, (std::uint32_t)payload.size());
+        putLittleEndian(bytes, crc32(payload));
+        bytes.append(payload.begin(), payload.end());
+        std::vector<unsigned char> end{1, 0, 0, 0, 0, 0, 0, 0};
+        putLittleEndian(bytes, 0);
+        putLittleEndian(bytes, (std::uint32_t)end.size());
+        putLittleEndian(bytes, crc32(end));
+        bytes.append(end.begin(), end.end());
+        return bytes;
+    }
+}
+
+TEST_SUITE("Binary fraction columns")
+{
+    TEST_CASE("Round trip including extreme values")
+    {
+        std::vector<Fraction> values = sampleColumn();
+        std::stringstream binary;
+        write_fraction_column(binary, values);
+        CHECK(sameValues(read_fraction_column(binary), values));
+
+        std::ostringstream text;
+        for (const Fraction &value : values)
+        {
+            text << value << "\n";
+        }
+        CHECK(binary.str().size() * 2 < text.str().size());
+    }
+
+    TEST_CASE("Empty column")
+    {
+        std::stringstream binary;
+        write_fraction_column(binary, {});
+        CHECK(binary.str().size() == 8 + 12 + 8);
+        CHECK(read_fraction_column(binary).empty());
+    }
+
+    TEST_CASE("Streaming writes and reads in arbitrary batches")
+    {
+        std::vector<Fraction> values = sampleColumn();
+        std::stringstream binary;
+        {
+            FractionBinaryWriter writer(binary, 100);
+            for (const Fraction &value : values)
+            {
+                writer.write(value);
+            }
+            writer.finish();
+        }
+        FractionBinaryReader reader(binary);
+        std::vector<Fraction> decoded;
+        std::vector<Fraction> batch(333);
+        std::size_t count = 0;
+        while ((count = reader.read(batch)) != 0)
+        {
+            decoded.insert(decoded.end(), batch.begin(), batch.begin() + (std::ptrdiff_t)count);
+        }
+        CHECK(sameValues(decoded, values));
+        CHECK(reader.read(batch) == 0);
+
+        FractionBinaryWriter finished(binary);
+        finished.finish();
+        CHECK_THROWS_AS(finished.write(Fraction(1, 2)), std::logic_error);
+    }
+
+    TEST_CASE("A writer destroyed before finish leaves an unreadable column")
+    {
+        std::vector<Fraction> values = sampleColumn();
+        std::stringstream binary;
+        {
+            FractionBinaryWriter writer(binary, 100);
+            writer.write(values);
+        }
+        CHECK_THROWS_AS(read_fraction_column(binary), std::runtime_error);
+    }
+
+    TEST_CASE("Damaged data is rejected")
+    {
+        std::stringstream binary;
+        write_fraction_column(binary, sampleColumn());
+        std::string bytes = binary.str();
+
+        std::string flipped = bytes;
+        flipped[100] = (char)(flipped[100] ^ 0x10);
+        std::istringstream flippedStream(flipped);
+        CHECK_THROWS_AS(read_fraction_column(flippedStream), std::runtime_error);
+
+        std::istringstream truncated(bytes.substr(0, bytes.size() - 5));
+        CHECK_THROWS_AS(read_fraction_column(truncated), std::runtime_error);
+
+        std::istringstream badMagic("FRAC\x01\x00\x00\x00");
+        CHECK_THROWS_AS(read_fraction_column(badMagic), std::runtime_error);
+
+        std::string newer = bytes;
+        newer[4] = 2;
+        std::istringstream newerStream(newer);
+        CHECK_THROWS_AS(read_fraction_column(newerStream), std::runtime_error);
+
+        std::istringstream valid(singleRecordColumn(4, 3));
+        CHECK(sameValues(read_fraction_column(valid), {Fraction(2, 3)}));
+        std::istringstream unreduced(singleRecordColumn(4, 4));
+        CHECK_THROWS_AS(read_fraction_column(unreduced), std::runtime_error);
+        std::istringstream zeroOverFive(singleRecordColumn(0, 5));
+        CHECK_THROWS_AS(read_fraction_column(zeroOverFive), std::runtime_error);
+        std::istringstream zeroDenominator(singleRecordColumn(4, 0));
+        CHECK_THROWS_AS(read_fraction_column(zeroDenominator), std::runtime_error);
+    }
+}
@@ -0,0 +1,50 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include <limits>
+#include <stdexcept>
+using namespace ariel;
+
+TEST_SUITE("Compound assignment")
+{
+    TEST_CASE("Compound operators return a reference to the object")
+    {
+        Fraction a(1, 2), b(1, 3);
+        Fraction &sum = (a += b);
+        CHECK(&sum == &a);
+        CHECK(((a.getNumerator() == 5) && (a.getDenominator() == 6)));
+
+        (a -= b) *= Fraction(4, 1);
+        CHECK(((a.getNumerator() == 2) && (a.getDenominator() == 1)));
+
+        (a /= Fraction(-3, 1)) += 1.0;
+        CHECK(((a.getNumerator() == 1) && (a.getDenominator() == 3)));
+
+        Fraction &scaled = (a *= 0.5);
+        CHECK(&scaled == &a);
+        CHECK(((a.getNumerator() == 1) && (a.getDenominator() == 6)));
+    }
+
+    TEST_CASE("Compound operators keep the sign on the numerator and reduce")
+    {
+        Fraction a(3, 4);
+        a /= Fraction(-3, 8);
+        CHECK(((a.getNumerator() == -2) && (a.getDenominator() == 1)));
+        a -= Fraction(-2, 1);
+        CHECK(((a.getNumerator() == 0) && (a.getDenominator() == 1)));
+    }
+
+    TEST_CASE("Compound operators leave the object unchanged when they throw")
+    {
+        int max_int = std::numeric_limits<int>::max();
+        Fraction a(max_int, 1);
+        CHECK_THROWS_AS(a += a, std::overflow_error);
+        CHECK_THROWS_AS(a *= Fraction(2, 1), std::overflow_error);
+        CHECK_THROWS_AS(a /= Fraction(), std::runtime_error);
+        CHECK_THROWS_AS(a /= 0.0, std::runtime_error);
+        CHECK(((a.getNumerator() == max_int) && (a.getDenominator() == 1)));
+
+        Fraction small(1, 65536);
+        CHECK_THROWS_AS(small * small, std::overflow_error);
+        CHECK_THROWS_AS(small + Fraction(1, 65535), std::overflow_error);
+    }
+}
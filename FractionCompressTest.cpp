@@ -0,0 +1,206 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionBinary.hpp"
+#include "sources/FractionCompress.hpp"
+#include "sources/FractionSort.hpp"
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace ariel;
+
+namespace
+{
+    bool sameValues(const std::vector<Fraction> &left, const std::vector<Fraction> &right)
+    {
+        if (left.size() != right.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < left.size(); ++i)
+        {
+            if (left[i].getNumerator() != right[i].getNumerator() || left[i].getDenominator() != right[i].getDenominator())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// sorted prices in cents, the typical shape of an archived column
+    std::vector<Fraction> sortedColumn()
+    {
+        std::vector<Fraction> values;
+        for (int i = 0; i < 20000; ++i)
+        {
+            values.emplace_back(100000 + i * 3 + (i % 7), 100);
+        }
+        sort_fractions(values, 1);
+        return values;
+    }
+
+    const std::size_t BYTES_FIELD_OFFSET = 36;
+    const std::size_t CHECKSUM_OFFSET = 44;
+    /// start of the encoded blocks of a serialized single block column
+    const std::size_t PAYLOAD_OFFSET = CHECKSUM_OFFSET + 2 * sizeof(std::uint64_t);
+
+    void putField(std::string &bytes, std::size_t offset, std::uint64_t value)
+    {
+        for (std::size_t byte = 0; byte < sizeof(value); ++byte)
+        {
+            bytes[offset + byte] = (char)((value >> (8 * byte)) & 0xFFU);
+        }
+    }
+
+    /// fix the payload size and checksum of a serialized single block column after its block was edited,
+    /// so only the block validation can catch the change
+    void resealColumn(std::string &bytes)
+    {
+        std::span<const unsigned char> payload(reinterpret_cast<const unsigned char *>(bytes.data()) + PAYLOAD_OFFSET, bytes.size() - PAYLOAD_OFFSET);
+        putField(bytes, BYTES_FIELD_OFFSET, payload.size());
+        putField(bytes, CHECKSUM_OFFSET, crc32(payload));
+    }
+
+    /// serialized single value column with the last payload byte, the numerator varint, replaced
+    std::string withNumeratorByte(const Fraction &value, unsigned char numeratorZigzag)
+    {
+        std::stringstream stream;
+        std::vector<Fraction> values{value};
+        CompressedFractionColumn(values, 1).write(stream);
+        std::string bytes = stream.str();
+        bytes.back() = (char)numeratorZigzag;
+        resealColumn(bytes);
+        return bytes;
+    }
+
+    /// serialized column of valueCount values in a single block whose encoding is replaced by block
+    std::string withBlock(std::size_t valueCount, const std::vector<unsigned char> &block)
+    {
+        std::stringstream stream;
+        std::vector<Fraction> values(valueCount);
+        CompressedFractionColumn(values, valueCount).write(stream);
+        std::string bytes = stream.str().substr(0, PAYLOAD_OFFSET);
+        bytes.append(block.begin(), block.end());
+        resealColumn(bytes);
+        return bytes;
+    }
+}
+
+TEST_SUITE("Compressed fraction columns")
+{
+    TEST_CASE("Sorted column round trips and compresses well")
+    {
+        std::vector<Fraction> values = sortedColumn();
+        CompressedFractionColumn column(values, 512);
+        CHECK(column.size() == values.size());
+        CHECK(column.blockCount() == (values.size() + 511) / 512);
+        CHECK(sameValues(column.decode(), values));
+        CHECK(column.compressedBytes() * 8 < values.size() * sizeof(Fraction));
+    }
+
+    TEST_CASE("Unsorted and extreme values round trip")
+    {
+        int max_int = std::numeric_limits<int>::max();
+        int min_int = std::numeric_limits<int>::min();
+        std::vector<Fraction> values{Fraction(max_int), Fraction(min_int), Fraction(max_int), Fraction(1, max_int), Fraction(min_int, max_int),
+                                     Fraction(-1, max_int), Fraction(), Fraction(), Fraction(5, 3), Fraction(-5, 3), Fraction(7, 3)};
+        for (int i = 0; i < 1000; ++i)
+        {
+            values.emplace_back((i * 7919) % 2001 - 1000, i % 3 + 1);
+        }
+        for (std::size_t blockSize : {1U, 3U, 64U, 100000U})
+        {
+            CompressedFractionColumn column(values, blockSize);
+            CHECK(sameValues(column.decode(), values));
+        }
+        CHECK(CompressedFractionColumn(std::vector<Fraction>{}).decode().empty());
+        CHECK_THROWS_AS(CompressedFractionColumn(values, 0), std::invalid_argument);
+    }
+
+    TEST_CASE("Block level random access")
+    {
+        std::vector<Fraction> values = sortedColumn();
+        CompressedFractionColumn column(values, 256);
+        for (std::size_t index : {std::size_t(0), std::size_t(255), std::size_t(256), std::size_t(12345), values.size() - 1})
+        {
+            Fraction value = column.at(index);
+            CHECK(value.getNumerator() == values[index].getNumerator());
+            CHECK(value.getDenominator() == values[index].getDenominator());
+        }
+        std::vector<Fraction> block(256);
+        CHECK(column.decodeBlock(column.blockCount() - 1, block) == values.size() % 256);
+        CHECK_THROWS_AS(column.at(values.size()), std::out_of_range);
+        CHECK_THROWS_AS(column.decodeBlock(column.blockCount(), block), std::out_of_range);
+        std::vector<Fraction> small(10);
+        CHECK_THROWS_AS(column.decodeBlock(0, small), std::invalid_argument);
+    }
+
+    TEST_CASE("Serialized columns are checksummed")
+    {
+        std::vector<Fraction> values = sortedColumn();
+        std::stringstream stream;
+        CompressedFractionColumn(values, 1000).write(stream);
+        std::string bytes = stream.str();
+        CHECK(sameValues(CompressedFractionColumn::read(stream).decode(), values));
+
+        bytes[bytes.size() / 2] = (char)(bytes[bytes.size() / 2] ^ 1);
+        std::istringstream damaged(bytes);
+        CHECK_THROWS_AS(CompressedFractionColumn::read(damaged), std::runtime_error);
+
+        std::istringstream truncated(bytes.substr(0, 30));
+        CHECK_THROWS_AS(CompressedFractionColumn::read(truncated), std::runtime_error);
+    }
+
+    TEST_CASE("Short blocks and overflowing deltas are rejected on decode")
+    {
+        // count, dictionary size, denominator 1, common denominator mode, index width 0, numerator 1
+        std::vector<unsigned char> oneValue{1, 1, 1, 1, 0, 2};
+        std::istringstream valid(withBlock(1, oneValue));
+        CHECK(sameValues(CompressedFractionColumn::read(valid).decode(), {Fraction(1)}));
+
+        std::istringstream shortBlock(withBlock(2, oneValue));
+        CompressedFractionColumn shortColumn = CompressedFractionColumn::read(shortBlock);
+        CHECK_THROWS_AS(shortColumn.decode(), std::runtime_error);
+        CHECK_THROWS_AS(shortColumn.at(1), std::runtime_error);
+
+        // two values, first numerator and minimal delta both INT64_MAX, delta width 0
+        std::vector<unsigned char> overflowing{2, 1, 1, 1, 0};
+        for (int varint = 0; varint < 2; ++varint)
+        {
+            overflowing.insert(overflowing.end(), {0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01});
+        }
+        overflowing.push_back(0);
+        std::istringstream overflow(withBlock(2, overflowing));
+        CHECK_THROWS_AS(CompressedFractionColumn::read(overflow).decode(), std::runtime_error);
+    }
+
+    TEST_CASE("Block sizes are bounded")
+    {
+        std::vector<Fraction> values{Fraction(1, 2)};
+        CHECK_THROWS_AS(CompressedFractionColumn(values, FRACTION_COMPRESS_MAX_BLOCK + 1), std::invalid_argument);
+        std::stringstream stream;
+        CompressedFractionColumn(values, 1).write(stream);
+        std::string bytes = stream.str();
+        putField(bytes, 20, FRACTION_COMPRESS_MAX_BLOCK + 1);
+        std::istringstream oversized(bytes);
+        CHECK_THROWS_AS(CompressedFractionColumn::read(oversized), std::runtime_error);
+    }
+
+    TEST_CASE("Unreduced records are rejected on decode")
+    {
+        int max_int = std::numeric_limits<int>::max();
+        std::istringstream valid(withNumeratorByte(Fraction(1, 3), 4));
+        CHECK(sameValues(CompressedFractionColumn::read(valid).decode(), {Fraction(2, 3)}));
+
+        std::istringstream common(withNumeratorByte(Fraction(1, 3), 6));
+        CompressedFractionColumn commonColumn = CompressedFractionColumn::read(common);
+        CHECK_THROWS_AS(commonColumn.decode(), std::runtime_error);
+
+        std::istringstream runs(withNumeratorByte(Fraction(1, max_int), 0));
+        CompressedFractionColumn runsColumn = CompressedFractionColumn::read(runs);
+        CHECK_THROWS_AS(runsColumn.at(0), std::runtime_error);
+    }
+}
@@ -0,0 +1,62 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionExpr.hpp"
+#include <limits>
+#include <stdexcept>
+using namespace ariel;
+
+TEST_SUITE("Expression templates")
+{
+    TEST_CASE("Expression evaluates to the same reduced value as the eager operators")
+    {
+        Fraction a(1, 2), b(1, 3), c(3, 4), d(2, 5);
+        Fraction eager = a + b - c * d;
+        Fraction lazyResult = lazy(a) + b - c * lazy(d);
+        CHECK(lazyResult.getNumerator() == eager.getNumerator());
+        CHECK(lazyResult.getDenominator() == eager.getDenominator());
+
+        Fraction quotient = lazy(a) / b + c;
+        CHECK(quotient.getNumerator() == 9);
+        CHECK(quotient.getDenominator() == 4);
+    }
+
+    TEST_CASE("Mixed Fraction and float operands")
+    {
+        Fraction a(1, 4);
+        Fraction result = lazy(a) + 0.25 - 1;
+        CHECK(result.getNumerator() == -1);
+        CHECK(result.getDenominator() == 2);
+    }
+
+    TEST_CASE("Zero results are normalized")
+    {
+        Fraction a(2, 7);
+        Fraction result = lazy(a) - a;
+        CHECK(result.getNumerator() == 0);
+        CHECK(result.getDenominator() == 1);
+    }
+
+    TEST_CASE("Only the final result is range checked")
+    {
+        int max_int = std::numeric_limits<int>::max();
+        Fraction big(max_int, 1), almost(max_int - 100, max_int);
+
+        // The eager operator overflows on the unreduced product, the expression reduces first
+        CHECK_THROWS_AS(big * almost, std::overflow_error);
+        Fraction product = lazy(big) * almost;
+        CHECK(product.getNumerator() == max_int - 100);
+        CHECK(product.getDenominator() == 1);
+
+        Fraction sum = lazy(big) + big - big;
+        CHECK(sum.getNumerator() == max_int);
+
+        CHECK_THROWS_AS(Fraction(lazy(big) + big), std::overflow_error);
+    }
+
+    TEST_CASE("Division by zero inside an expression")
+    {
+        Fraction a(1, 2), zero;
+        CHECK_THROWS_AS(Fraction(lazy(a) / zero), std::runtime_error);
+        CHECK_THROWS_AS(Fraction(lazy(a) / (lazy(a) - a)), std::runtime_error);
+    }
+}
@@ -0,0 +1,121 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionFormat.hpp"
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace ariel;
+
+TEST_SUITE("Fraction formatting")
+{
+    TEST_CASE("to_chars writes the same text as operator<<")
+    {
+        int min_int = std::numeric_limits<int>::min();
+        int max_int = std::numeric_limits<int>::max();
+        std::vector<Fraction> values{Fraction(3, 4), Fraction(-6, 8), Fraction(5), Fraction(), Fraction(min_int, max_int)};
+        for (const Fraction &value : values)
+        {
+            std::array<char, FRACTION_CHARS_MAX> buffer{};
+            std::to_chars_result result = to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+            REQUIRE(result.ec == std::errc());
+            std::ostringstream expected;
+            expected << value;
+            CHECK(std::string(buffer.data(), result.ptr) == expected.str());
+        }
+    }
+
+    TEST_CASE("to_chars reports a short buffer")
+    {
+        std::array<char, 4> buffer{};
+        std::to_chars_result result = to_chars(buffer.data(), buffer.data() + buffer.size(), Fraction(-10, 3));
+        CHECK(result.ec == std::errc::value_too_large);
+        CHECK(result.ptr == buffer.data() + buffer.size());
+        result = to_chars(buffer.data(), buffer.data() + 2, Fraction(12, 1));
+        CHECK(result.ec == std::errc::value_too_large);
+        result = to_chars(buffer.data(), buffer.data() + buffer.size(), Fraction(1, 12));
+        CHECK(result.ec == std::errc());
+    }
+
+    TEST_CASE("Buffered writer matches an operator<< loop")
+    {
+        std::vector<Fraction> values;
+        std::ostringstream expected;
+        for (int i = 1; i <= 1000; ++i)
+        {
+            values.emplace_back(i * 7 - 3000, i);
+            expected << values.back() << "\n";
+        }
+        std::ostringstream actual;
+        {
+            // a tiny buffer forces many intermediate flushes
+            FractionWriter writer(actual, 32);
+            writer.write(values);
+        }
+        CHECK(actual.str() == expected.str());
+
+        std::ostringstream bulk;
+        write_fractions(bulk, values);
+        CHECK(bulk.str() == expected.str());
+
+        std::ostringstream separated;
+        FractionWriter writer(separated);
+        writer.write(Fraction(1, 2), ',');
+        writer.write(Fraction(2, 3), ',');
+        writer.flush();
+        CHECK(separated.str() == "1/2,2/3,");
+    }
+
+    TEST_CASE("Format specifications")
+    {
+        FractionFormatSpec spec;
+        CHECK(parse_format_spec("", spec));
+        CHECK(spec.style == FractionStyle::ratio);
+        CHECK(parse_format_spec(".5f", spec));
+        CHECK(spec.style == FractionStyle::decimal);
+        CHECK(spec.precision == 5);
+        CHECK(parse_format_spec("m", spec));
+        CHECK(spec.style == FractionStyle::mixed);
+        CHECK_FALSE(parse_format_spec(".2m", spec));
+        CHECK_FALSE(parse_format_spec(".f", spec));
+        CHECK_FALSE(parse_format_spec(".33f", spec));
+        CHECK_FALSE(parse_format_spec("x", spec));
+        CHECK_FALSE(parse_format_spec("ff", spec));
+        CHECK_THROWS_AS(format_fraction(Fraction(1, 2), "q"), std::invalid_argument);
+    }
+
+    TEST_CASE("Mixed number presentation")
+    {
+        CHECK(format_fraction(Fraction(3, 2), "m") == "1 1/2");
+        CHECK(format_fraction(Fraction(-9, 4), "m") == "-2 1/4");
+        CHECK(format_fraction(Fraction(-1, 4), "m") == "-1/4");
+        CHECK(format_fraction(Fraction(6, 3), "m") == "2");
+        CHECK(format_fraction(Fraction(), "m") == "0");
+        CHECK(format_fraction(Fraction(3, 2)) == "3/2");
+    }
+
+    TEST_CASE("Decimal presentation rounds the last digit half away from zero")
+    {
+        CHECK(format_fraction(Fraction(1, 3), "f") == "0.333");
+        CHECK(format_fraction(Fraction(2, 3), ".2f") == "0.67");
+        CHECK(format_fraction(Fraction(-2, 3), ".2f") == "-0.67");
+        CHECK(format_fraction(Fraction(1, 8), ".2f") == "0.13");
+        CHECK(format_fraction(Fraction(-1, 8), ".2f") == "-0.13");
+        CHECK(format_fraction(Fraction(1999, 2000), ".2f") == "1.00");
+        CHECK(format_fraction(Fraction(7, 2), ".0f") == "4");
+        CHECK(format_fraction(Fraction(-1, 3000), "f") == "0.000");
+        CHECK(format_fraction(Fraction(1, 7), ".32f") == "0.14285714285714285714285714285714");
+        int min_int = std::numeric_limits<int>::min();
+        CHECK(format_fraction(Fraction(min_int, 1), ".1f") == "-2147483648.0");
+    }
+
+#ifdef __cpp_lib_format
+    TEST_CASE("std::format uses the same presentations")
+    {
+        Fraction value(-9, 4);
+        CHECK(std::format("{} {:m} {:.1f}", value, value, value) == "-9/4 -2 1/4 -2.3");
+    }
+#endif
+}
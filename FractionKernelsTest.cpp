@@ -0,0 +1,58 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionKernels.hpp"
+#include <limits>
+#include <stdexcept>
+#include <vector>
+using namespace ariel;
+
+TEST_SUITE("Fused kernels")
+{
+    TEST_CASE("fma matches the separate operators")
+    {
+        Fraction a(2, 3), b(3, 8), c(1, 6);
+        Fraction result = fma(a, b, c);
+        Fraction expected = a * b + c;
+        CHECK(result.getNumerator() == expected.getNumerator());
+        CHECK(result.getDenominator() == expected.getDenominator());
+        CHECK(fma(a, Fraction(), c).getNumerator() == 1);
+        CHECK(fma(a, Fraction(), c).getDenominator() == 6);
+    }
+
+    TEST_CASE("fma reduces before range checking")
+    {
+        int max_int = std::numeric_limits<int>::max();
+        Fraction big(max_int, 1), almost(max_int - 100, max_int);
+        Fraction result = fma(big, almost, Fraction(100));
+        CHECK(result.getNumerator() == max_int);
+        CHECK(result.getDenominator() == 1);
+        CHECK_THROWS_AS(fma(big, big, Fraction()), std::overflow_error);
+    }
+
+    TEST_CASE("dot product of fraction vectors")
+    {
+        std::vector<Fraction> weights{Fraction(1, 2), Fraction(1, 3), Fraction(-1, 4)};
+        std::vector<Fraction> inputs{Fraction(2, 5), Fraction(3, 7), Fraction(1, 1)};
+        Fraction expected = weights[0] * inputs[0] + weights[1] * inputs[1] + weights[2] * inputs[2];
+        Fraction result = dot(weights, inputs);
+        CHECK(result.getNumerator() == expected.getNumerator());
+        CHECK(result.getDenominator() == expected.getDenominator());
+
+        std::vector<Fraction> empty;
+        CHECK(dot(empty, empty).getNumerator() == 0);
+        CHECK_THROWS_AS(dot(weights, empty), std::invalid_argument);
+    }
+
+    TEST_CASE("dot product with many distinct denominators stays exact")
+    {
+        std::vector<Fraction> weights, inputs;
+        for (int i = 1; i <= 40; ++i)
+        {
+            weights.emplace_back(1, i);
+            inputs.emplace_back(i, 1);
+        }
+        Fraction result = dot(weights, inputs);
+        CHECK(result.getNumerator() == 40);
+        CHECK(result.getDenominator() == 1);
+    }
+}
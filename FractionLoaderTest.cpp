@@ -0,0 +1,85 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionLoader.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+using namespace ariel;
+
+TEST_SUITE("Bulk fraction loader")
+{
+    TEST_CASE("Lines are parsed in order and errors carry offset and line")
+    {
+        std::string text = "1/2\n\n 3 4\r\n1 1/2\nbad\n2/0\n5/6 junk\n-7";
+        FractionLoadResult result = parse_fraction_lines(text, 1);
+        REQUIRE(result.values.size() == 4);
+        CHECK(result.values[0].getNumerator() == 1);
+        CHECK(result.values[1].getDenominator() == 4);
+        CHECK(result.values[2].getNumerator() == 3);
+        CHECK(result.values[3].getNumerator() == -7);
+
+        REQUIRE(result.errors.size() == 3);
+        CHECK(result.errors[0].line == 5);
+        CHECK(result.errors[0].offset == text.find("bad"));
+        CHECK(result.errors[0].error == FractionParseError::invalidInput);
+        CHECK(result.errors[1].line == 6);
+        CHECK(result.errors[1].error == FractionParseError::zeroDenominator);
+        CHECK(result.errors[2].line == 7);
+        CHECK(result.errors[2].offset == text.find("junk"));
+    }
+
+    TEST_CASE("Parallel chunks give the same result as a single thread")
+    {
+        std::string text;
+        for (int i = 0; i < 200000; ++i)
+        {
+            text += std::to_string(i - 100000) + "/" + std::to_string(i % 97 + 1) + "\n";
+            if (i % 50000 == 0)
+            {
+                text += "x\n";
+            }
+        }
+        FractionLoadResult serial = parse_fraction_lines(text, 1);
+        FractionLoadResult parallel = parse_fraction_lines(text, 4);
+        REQUIRE(serial.values.size() == 200000);
+        REQUIRE(parallel.values.size() == serial.values.size());
+        bool same = true;
+        for (std::size_t i = 0; i < serial.values.size(); ++i)
+        {
+            same = same && serial.values[i].getNumerator() == parallel.values[i].getNumerator() &&
+                   serial.values[i].getDenominator() == parallel.values[i].getDenominator();
+        }
+        CHECK(same);
+        REQUIRE(parallel.errors.size() == 4);
+        for (std::size_t i = 0; i < parallel.errors.size(); ++i)
+        {
+            CHECK(parallel.errors[i].line == serial.errors[i].line);
+            CHECK(parallel.errors[i].offset == serial.errors[i].offset);
+        }
+        CHECK(parallel.errors[1].line == 50003);
+    }
+
+    TEST_CASE("Files are memory mapped")
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "fraction_loader_test.txt";
+        {
+            std::ofstream file(path);
+            file << "2/4\n6 9\n";
+        }
+        FractionLoadResult result = load_fractions(path.string());
+        REQUIRE(result.values.size() == 2);
+        CHECK(result.values[1].getNumerator() == 2);
+        CHECK(result.values[1].getDenominator() == 3);
+        std::filesystem::remove(path);
+
+        {
+            std::ofstream file(path);
+        }
+        CHECK(load_fractions(path.string()).values.empty());
+        std::filesystem::remove(path);
+
+        CHECK_THROWS_AS(load_fractions(path.string()), std::runtime_error);
+    }
+}
@@ -0,0 +1,91 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionParse.hpp"
+#include <string>
+#include <string_view>
+using namespace ariel;
+
+namespace
+{
+    bool parsesTo(std::string_view text, int numerator, int denominator)
+    {
+        Fraction value;
+        FractionParseResult result = parse_fraction(text, value);
+        return result.error == FractionParseError::none && value.getNumerator() == numerator && value.getDenominator() == denominator;
+    }
+
+    FractionParseError errorOf(std::string_view text)
+    {
+        Fraction value;
+        return parse_fraction(text, value).error;
+    }
+}
+
+TEST_SUITE("Fraction parser")
+{
+    TEST_CASE("Accepted forms")
+    {
+        CHECK(parsesTo("3/4", 3, 4));
+        CHECK(parsesTo("6/-8", -3, 4));
+        CHECK(parsesTo("6 8", 3, 4));
+        CHECK(parsesTo("\t -7", -7, 1));
+        CHECK(parsesTo("+5", 5, 1));
+        CHECK(parsesTo("1.25", 5, 4));
+        CHECK(parsesTo("-0.5", -1, 2));
+        CHECK(parsesTo("0.333", 333, 1000));
+        CHECK(parsesTo("1 1/2", 3, 2));
+        CHECK(parsesTo("-2 1/4", -9, 4));
+        CHECK(parsesTo("0/5", 0, 1));
+    }
+
+    TEST_CASE("Bytes consumed stop at the end of the value")
+    {
+        Fraction value;
+        FractionParseResult result = parse_fraction("  12/18,next", value);
+        CHECK(result.consumed == 7);
+        CHECK(value.getNumerator() == 2);
+
+        result = parse_fraction("4 apples", value);
+        CHECK(result.consumed == 1);
+        CHECK(value.getNumerator() == 4);
+
+        result = parse_fraction("1 1/2\n", value);
+        CHECK(result.consumed == 5);
+
+        result = parse_fraction("2.\n", value);
+        CHECK(result.consumed == 1);
+        CHECK(value.getNumerator() == 2);
+    }
+
+    TEST_CASE("Errors are reported without throwing")
+    {
+        Fraction value(1, 3);
+        FractionParseResult result = parse_fraction("abc", value);
+        CHECK(result.error == FractionParseError::invalidInput);
+        CHECK(result.consumed == 0);
+        CHECK(value.getDenominator() == 3);
+
+        CHECK(errorOf("") == FractionParseError::invalidInput);
+        CHECK(errorOf("3/") == FractionParseError::invalidInput);
+        CHECK(errorOf("1 -1/2") == FractionParseError::invalidInput);
+        CHECK(errorOf("1/0") == FractionParseError::zeroDenominator);
+        CHECK(errorOf("5 0") == FractionParseError::zeroDenominator);
+        CHECK(errorOf("2147483648") == FractionParseError::overflow);
+        CHECK(errorOf("99999999999999999999999") == FractionParseError::overflow);
+        CHECK(errorOf("0.0000000001") == FractionParseError::overflow);
+        CHECK(errorOf("18446744073709551615 18446744073709551615/3") == FractionParseError::overflow);
+
+        std::string padded = std::string(FRACTION_LINE_MAX - 3, ' ') + "1/2";
+        CHECK(parse_fraction_line(padded.data(), padded.data() + padded.size(), value).error == FractionParseError::none);
+        padded.insert(0, " ");
+        result = parse_fraction_line(padded.data(), padded.data() + padded.size(), value);
+        CHECK(result.error == FractionParseError::lineTooLong);
+        CHECK(result.consumed == FRACTION_LINE_MAX);
+    }
+
+    TEST_CASE("Overflow is checked after reduction")
+    {
+        CHECK(parsesTo("4294967294/2", 2147483647, 1));
+        CHECK(parsesTo("-2147483648", -2147483647 - 1, 1));
+    }
+}
@@ -0,0 +1,182 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionLoader.hpp"
+#include "sources/FractionPipeline.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace ariel;
+
+namespace
+{
+    /// stream buffer that serves some text and then fails like a broken device
+    class FailingBuffer : public std::streambuf
+    {
+    private:
+        std::string text;
+        bool served = false;
+
+    protected:
+        int_type underflow() override
+        {
+            if (served)
+            {
+                throw std::runtime_error("device error");
+            }
+            served = true;
+            setg(text.data(), text.data(), text.data() + text.size());
+            return traits_type::to_int_type(text[0]);
+        }
+
+    public:
+        explicit FailingBuffer(std::string served) : text(std::move(served)) {}
+    };
+}
+
+TEST_SUITE("Fraction pipeline")
+{
+    TEST_CASE("Output keeps input order for any chunk size and thread count")
+    {
+        std::string text;
+        for (int i = 0; i < 3000; ++i)
+        {
+            text += std::to_string(i) + " 4\n";
+        }
+        std::ostringstream reference;
+        for (int i = 0; i < 3000; ++i)
+        {
+            reference << Fraction(i, 4) << "\n";
+        }
+        for (std::size_t chunkBytes : {1U, 5U, 100U, 1U << 16})
+        {
+            for (unsigned threads : {1U, 3U})
+            {
+                FractionPipelineConfig config;
+                config.chunkBytes = chunkBytes;
+                config.parseThreads = threads;
+                config.computeThreads = threads;
+                config.formatThreads = threads;
+                config.queueCapacity = 2;
+                std::istringstream input(text);
+                std::ostringstream output;
+                FractionPipelineStats stats = FractionPipeline(config).run(input, output);
+                CHECK(output.str() == reference.str());
+                CHECK(stats.valuesRead == 3000);
+                CHECK(stats.valuesWritten == 3000);
+                REQUIRE(stats.stages.size() == 5);
+                CHECK(stats.stages[0].name == "read");
+                CHECK(stats.stages[0].items == text.size());
+                CHECK(stats.stages[2].threads == threads);
+                CHECK(stats.stages[4].items == reference.str().size());
+                CHECK(stats.stages[1].batches == stats.stages[4].batches);
+            }
+        }
+    }
+
+    TEST_CASE("Kernels map and filter, errors match the bulk loader")
+    {
+        std::string text = "1/2\n\n 3 4\r\nbad\n2/0\n-5/6\n7 junk\n-7";
+        FractionLoadResult expected = parse_fraction_lines(text, 1);
+        FractionPipelineConfig config;
+        config.chunkBytes = 4;
+        config.computeThreads = 2;
+        FractionPipeline pipeline(config);
+        pipeline.addKernel([](std::span<Fraction> batch)
+                           {
+                    std::size_t kept = 0;
+                    for (const Fraction &value : batch)
+                    {
+                        if (value.getNumerator() > 0)
+                        {
+                            batch[kept++] = value;
+                        }
+                    }
+                    return kept; })
+            .addKernel([](std::span<Fraction> batch)
+                       {
+                    for (Fraction &value : batch)
+                    {
+                        value *= Fraction(2);
+                    }
+                    return batch.size(); });
+        std::istringstream input(text);
+        std::ostringstream output;
+        FractionPipelineStats stats = pipeline.run(input, output);
+        CHECK(output.str() == "1/1\n3/2\n");
+        CHECK(stats.valuesRead == 4);
+        CHECK(stats.valuesWritten == 2);
+        REQUIRE(stats.errorCount == expected.errors.size());
+        REQUIRE(stats.errors.size() == expected.errors.size());
+        for (std::size_t i = 0; i < stats.errors.size(); ++i)
+        {
+            CHECK(stats.errors[i].line == expected.errors[i].line);
+            CHECK(stats.errors[i].offset == expected.errors[i].offset);
+            CHECK(stats.errors[i].error == expected.errors[i].error);
+        }
+    }
+
+    TEST_CASE("Over-long lines are rejected and skipped")
+    {
+        std::string longLine(FRACTION_LINE_MAX * 20, '7');
+        std::string text = longLine + "\n1/2\n" + longLine + "\n3/4\n" + std::string(FRACTION_LINE_MAX - 3, ' ') + "5/6\n" + longLine;
+        FractionLoadResult expected = parse_fraction_lines(text, 1);
+        REQUIRE(expected.errors.size() == 3);
+        std::ostringstream reference;
+        for (const Fraction &value : expected.values)
+        {
+            reference << value << "\n";
+        }
+        for (std::size_t chunkBytes : {1U, 7U, 300U, 1U << 16})
+        {
+            FractionPipelineConfig config;
+            config.chunkBytes = chunkBytes;
+            std::istringstream input(text);
+            std::ostringstream output;
+            FractionPipelineStats stats = FractionPipeline(config).run(input, output);
+            CHECK(output.str() == reference.str());
+            REQUIRE(stats.errors.size() == expected.errors.size());
+            for (std::size_t i = 0; i < stats.errors.size(); ++i)
+            {
+                CHECK(stats.errors[i].line == expected.errors[i].line);
+                CHECK(stats.errors[i].offset == expected.errors[i].offset);
+                CHECK(stats.errors[i].error == FractionParseError::lineTooLong);
+            }
+        }
+    }
+
+    TEST_CASE("A throwing kernel stops every stage and is rethrown")
+    {
+        std::string text;
+        for (int i = 0; i < 20000; ++i)
+        {
+            text += "2147483647/1\n";
+        }
+        FractionPipelineConfig config;
+        config.chunkBytes = 256;
+        config.computeThreads = 2;
+        FractionPipeline pipeline(config);
+        pipeline.addKernel([](std::span<Fraction> batch)
+                           {
+                    for (Fraction &value : batch)
+                    {
+                        value += Fraction(1);
+                    }
+                    return batch.size(); });
+        std::istringstream input(text);
+        std::ostringstream output;
+        CHECK_THROWS_AS(pipeline.run(input, output), std::overflow_error);
+    }
+
+    TEST_CASE("A failing input stream fails the run")
+    {
+        FailingBuffer buffer("1/2\n3/4\n");
+        std::istream input(&buffer);
+        std::ostringstream output;
+        FractionPipelineConfig config;
+        config.chunkBytes = 4;
+        CHECK_THROWS_AS(FractionPipeline(config).run(input, output), std::runtime_error);
+    }
+}
@@ -0,0 +1,90 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionPool.hpp"
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+using namespace ariel;
+
+TEST_SUITE("Fraction pool")
+{
+    TEST_CASE("Equal values share one id")
+    {
+        FractionPool pool;
+        std::uint32_t half = pool.intern(Fraction(1, 2));
+        CHECK(pool.intern(Fraction(2, 4)) == half);
+        CHECK(pool.intern(Fraction(-1, -2)) == half);
+        std::uint32_t third = pool.intern(Fraction(1, 3));
+        CHECK(third != half);
+        CHECK(pool.size() == 2);
+        CHECK(pool.find(Fraction(1, 2)) == half);
+        CHECK_FALSE(pool.find(Fraction(3, 4)).has_value());
+    }
+
+    TEST_CASE("Cached derived data")
+    {
+        FractionPool pool;
+        std::uint32_t identifier = pool.intern(Fraction(-7, 4));
+        CHECK(pool.value(identifier).getNumerator() == -7);
+        CHECK(pool.value(identifier).getDenominator() == 4);
+        CHECK(pool.toDouble(identifier) == -1.75);
+        CHECK(pool.decimal(identifier) == "-1.750");
+        CHECK(pool.decimal(pool.intern(Fraction(2, 3))) == "0.667");
+        CHECK(pool.decimal(pool.intern(Fraction(-1, 3000))) == "0.000");
+        CHECK_THROWS_AS(pool.value(100), std::out_of_range);
+    }
+
+    TEST_CASE("Columns and capacity")
+    {
+        FractionPool pool(3, 2);
+        std::vector<Fraction> column{Fraction(1, 2), Fraction(1, 3), Fraction(1, 2), Fraction(2, 6)};
+        std::vector<std::uint32_t> ids(column.size());
+        pool.intern(column, ids);
+        CHECK(ids[0] == ids[2]);
+        CHECK(ids[1] == ids[3]);
+        pool.intern(Fraction(5));
+        CHECK_THROWS_AS(pool.intern(Fraction(6)), std::length_error);
+        CHECK(pool.size() == 3);
+        std::vector<std::uint32_t> shortIds(1);
+        CHECK_THROWS_AS(pool.intern(column, shortIds), std::invalid_argument);
+    }
+
+    TEST_CASE("Values sharing a denominator fill every shard")
+    {
+        const int distinct = 1 << 14;
+        FractionPool pool(distinct, 16);
+        for (int i = 0; i < distinct; ++i)
+        {
+            CHECK(pool.intern(Fraction(i, 1)) == (std::uint32_t)i);
+        }
+        CHECK(pool.size() == (std::size_t)distinct);
+        CHECK(pool.find(Fraction(distinct - 1, 1)) == std::optional<std::uint32_t>(distinct - 1));
+        CHECK_THROWS_AS(pool.intern(Fraction(distinct, 1)), std::length_error);
+    }
+
+        TEST_CASE("Concurrent interning hands out one id per value")
+    {
+        FractionPool pool(4096, 8);
+        std::vector<std::vector<std::uint32_t>> results(4, std::vector<std::uint32_t>(1000));
+        std::vector<std::thread> workers;
+        for (std::size_t worker = 0; worker < results.size(); ++worker)
+        {
+            workers.emplace_back([&pool, &results, worker]()
+                                 {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    results[worker][(std::size_t)i] = pool.intern(Fraction(i % 500, 7));
+                } });
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        CHECK(pool.size() == 500);
+        for (std::size_t worker = 1; worker < results.size(); ++worker)
+        {
+            CHECK(results[worker] == results[0]);
+        }
+    }
+}
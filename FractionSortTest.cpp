@@ -0,0 +1,119 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionSort.hpp"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+using namespace ariel;
+
+namespace
+{
+    std::vector<Fraction> randomFractions(std::size_t count, int maxDenominator)
+    {
+        std::mt19937 generator(7);
+        std::uniform_int_distribution<int> numerator(-1000000, 1000000);
+        std::uniform_int_distribution<int> denominator(1, maxDenominator);
+        std::vector<Fraction> values;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            values.emplace_back(numerator(generator), denominator(generator));
+        }
+        return values;
+    }
+
+    bool sameValues(std::vector<Fraction> sorted, std::vector<Fraction> original)
+    {
+        std::sort(original.begin(), original.end(), ExactLess());
+        for (std::size_t i = 0; i < sorted.size(); ++i)
+        {
+            if (compareExact(sorted[i], original[i]) != 0)
+            {
+                return false;
+            }
+        }
+        return sorted.size() == original.size();
+    }
+}
+
+TEST_SUITE("Exact sorting")
+{
+    TEST_CASE("compareExact does not round to 3 digits")
+    {
+        CHECK(compareExact(Fraction(1, 3), Fraction(333, 1000)) > 0);
+        CHECK(compareExact(Fraction(-1, 2), Fraction(1, -2)) == 0);
+        CHECK(compareExact(Fraction(2147483646, 2147483647), Fraction(2147483645, 2147483646)) > 0);
+        CHECK(ExactLess()(Fraction(1, 1000000), Fraction(1, 999999)));
+    }
+
+    TEST_CASE("sort_fractions orders values that share a double key exactly")
+    {
+        // these differ by less than the resolution of a double near 1
+        std::vector<Fraction> values{Fraction(2147483646, 2147483647), Fraction(2147483645, 2147483646),
+                                     Fraction(1), Fraction(2147483644, 2147483645)};
+        sort_fractions(values);
+        CHECK(std::is_sorted(values.begin(), values.end(), ExactLess()));
+        CHECK(values.back().getNumerator() == 1);
+    }
+
+    TEST_CASE("sort_fractions and the parallel merge sort sort large inputs")
+    {
+        std::vector<Fraction> original = randomFractions(200000, 1000);
+        std::vector<Fraction> keyed = original;
+        sort_fractions(keyed, 4);
+        CHECK(std::is_sorted(keyed.begin(), keyed.end(), ExactLess()));
+        CHECK(sameValues(keyed, original));
+
+        std::vector<Fraction> merged = original;
+        parallel_merge_sort_fractions(merged, 3);
+        CHECK(std::is_sorted(merged.begin(), merged.end(), ExactLess()));
+        CHECK(sameValues(merged, original));
+    }
+
+    TEST_CASE("radix_sort_fractions with an exact key resolution")
+    {
+        std::vector<Fraction> original = randomFractions(50000, 1000);
+        std::vector<Fraction> values = original;
+        radix_sort_fractions(values, RadixKeyRange{Fraction(-1000000), Fraction(1000000), 1000});
+        CHECK(std::is_sorted(values.begin(), values.end(), ExactLess()));
+        CHECK(sameValues(values, original));
+    }
+
+    TEST_CASE("radix_sort_fractions falls back to exact fix up of equal keys")
+    {
+        // denominators far above the declared bound collide on the same keys
+        std::vector<Fraction> values{Fraction(2147483646, 2147483647), Fraction(1, 3), Fraction(2147483645, 2147483646),
+                                     Fraction(1), Fraction(0), Fraction(1, 3), Fraction(2147483644, 2147483645)};
+        std::vector<Fraction> original = values;
+        radix_sort_fractions(values, RadixKeyRange{Fraction(0), Fraction(1), 10});
+        CHECK(std::is_sorted(values.begin(), values.end(), ExactLess()));
+        CHECK(sameValues(values, original));
+
+        std::vector<Fraction> wideRange = randomFractions(20000, 1000000);
+        original = wideRange;
+        radix_sort_fractions(wideRange, RadixKeyRange{Fraction(-1000000), Fraction(1000000), 1000000});
+        CHECK(std::is_sorted(wideRange.begin(), wideRange.end(), ExactLess()));
+        CHECK(sameValues(wideRange, original));
+    }
+
+    TEST_CASE("radix_sort_fractions rejects values outside of the range")
+    {
+        std::vector<Fraction> values{Fraction(1, 2), Fraction(3, 2)};
+        CHECK_THROWS_AS(radix_sort_fractions(values, RadixKeyRange{Fraction(0), Fraction(1), 2}), std::out_of_range);
+        CHECK_THROWS_AS(radix_sort_fractions(values, RadixKeyRange{Fraction(1), Fraction(0), 2}), std::invalid_argument);
+        std::vector<Fraction> constant{Fraction(1, 2), Fraction(1, 2)};
+        radix_sort_fractions(constant, RadixKeyRange{Fraction(1, 2), Fraction(1, 2), 2});
+        CHECK(constant[1].getDenominator() == 2);
+    }
+
+    TEST_CASE("Sorting empty and single element inputs")
+    {
+        std::vector<Fraction> empty;
+        sort_fractions(empty);
+        parallel_merge_sort_fractions(empty);
+        CHECK(empty.empty());
+        std::vector<Fraction> single{Fraction(3, 4)};
+        sort_fractions(single, 8);
+        CHECK(single[0].getDenominator() == 4);
+    }
+}
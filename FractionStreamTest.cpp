@@ -0,0 +1,201 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionLoader.hpp"
+#include "sources/FractionStream.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace ariel;
+
+namespace
+{
+    std::vector<Fraction> readAll(std::istream &input, std::size_t chunkBytes, std::size_t batchSize, std::vector<FractionLoadError> &errors)
+    {
+        FractionStreamReader reader(input, chunkBytes);
+        std::vector<Fraction> values;
+        std::vector<Fraction> batch(batchSize);
+        std::size_t count = 0;
+        while ((count = reader.read(batch)) != 0)
+        {
+            values.insert(values.end(), batch.begin(), batch.begin() + (std::ptrdiff_t)count);
+        }
+        errors = reader.errors();
+        CHECK(reader.errorCount() == errors.size());
+        return values;
+    }
+
+    /// stream buffer that serves some text and then fails like a broken device
+    class FailingBuffer : public std::streambuf
+    {
+    private:
+        std::string text;
+        bool served = false;
+
+    protected:
+        int_type underflow() override
+        {
+            if (served)
+            {
+                throw std::runtime_error("device error");
+            }
+            served = true;
+            setg(text.data(), text.data(), text.data() + text.size());
+            return traits_type::to_int_type(text[0]);
+        }
+
+    public:
+        explicit FailingBuffer(std::string served) : text(std::move(served)) {}
+    };
+
+    /// the stream reader must give the values and errors of parse_fraction_lines whatever the chunk size
+    void checkMatchesLoader(const std::string &text, std::size_t chunkBytes, std::size_t batchSize)
+    {
+        FractionLoadResult expected = parse_fraction_lines(text, 1);
+        std::istringstream input(text);
+        std::vector<FractionLoadError> errors;
+        std::vector<Fraction> values = readAll(input, chunkBytes, batchSize, errors);
+        REQUIRE(values.size() == expected.values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            CHECK(values[i].getNumerator() == expected.values[i].getNumerator());
+            CHECK(values[i].getDenominator() == expected.values[i].getDenominator());
+        }
+        REQUIRE(errors.size() == expected.errors.size());
+        for (std::size_t i = 0; i < errors.size(); ++i)
+        {
+            CHECK(errors[i].line == expected.errors[i].line);
+            CHECK(errors[i].offset == expected.errors[i].offset);
+            CHECK(errors[i].error == expected.errors[i].error);
+        }
+    }
+}
+
+TEST_SUITE("Fraction streams")
+{
+    TEST_CASE("Lines split across chunks match the bulk loader")
+    {
+        std::string text = "1/2\n\n 3 4\r\n1 1/2\nbad\n2/0\n-123456/7\n5/6 junk\n-7";
+        for (std::size_t chunkBytes : {1U, 3U, 7U, 4096U})
+        {
+            for (std::size_t batchSize : {1U, 2U, 100U})
+            {
+                checkMatchesLoader(text, chunkBytes, batchSize);
+            }
+        }
+    }
+
+    TEST_CASE("Over-long lines are rejected and skipped")
+    {
+        std::string longLine(FRACTION_LINE_MAX * 20, '7');
+        std::string text = "1/2\n" + longLine + "\n3/4\n" + std::string(FRACTION_LINE_MAX - 3, ' ') + "5/6\n" + longLine;
+        FractionLoadResult expected = parse_fraction_lines(text, 1);
+        REQUIRE(expected.values.size() == 3);
+        REQUIRE(expected.errors.size() == 2);
+        CHECK(expected.errors[0].error == FractionParseError::lineTooLong);
+        CHECK(expected.errors[0].offset == 4 + FRACTION_LINE_MAX);
+        CHECK(expected.errors[1].line == 5);
+        for (std::size_t chunkBytes : {1U, 64U, 4096U})
+        {
+            checkMatchesLoader(text, chunkBytes, 2);
+        }
+    }
+
+    TEST_CASE("Empty input and early destruction")
+    {
+        std::istringstream empty("");
+        std::vector<FractionLoadError> errors;
+        CHECK(readAll(empty, 16, 4, errors).empty());
+
+        std::string text;
+        for (int i = 0; i < 10000; ++i)
+        {
+            text += std::to_string(i) + "/3\n";
+        }
+        std::istringstream input(text);
+        FractionStreamReader reader(input, 64);
+        std::vector<Fraction> batch(5);
+        CHECK(reader.read(batch) == 5);
+        CHECK(batch[4].getNumerator() == 4);
+        CHECK(batch[3].getDenominator() == 1);
+    }
+
+    TEST_CASE("A failing input stream is an error, not the end of the input")
+    {
+        FailingBuffer buffer("1/2\n3/4\n");
+        std::istream input(&buffer);
+        std::vector<FractionLoadError> errors;
+        CHECK_THROWS_AS(readAll(input, 64, 4, errors), std::runtime_error);
+
+        FailingBuffer processed("1/2\n3/4\n");
+        std::istream processedInput(&processed);
+        std::ostringstream output;
+        CHECK_THROWS_AS(process_fraction_stream(processedInput, output, {}), std::runtime_error);
+    }
+
+    TEST_CASE("Writer output matches operator<<")
+    {
+        std::vector<Fraction> values;
+        std::ostringstream expected;
+        for (int i = 1; i <= 3000; ++i)
+        {
+            values.emplace_back(1000 - i * 7, i);
+            expected << values.back() << "\n";
+        }
+        std::ostringstream output;
+        FractionStreamWriter writer(output, 50);
+        writer.write(std::span<const Fraction>(values).first(1000));
+        writer.write(std::span<const Fraction>(values).subspan(1000));
+        writer.finish();
+        CHECK(output.str() == expected.str());
+        CHECK_THROWS_AS(writer.write(values), std::logic_error);
+
+        std::ostringstream unfinished;
+        {
+            FractionStreamWriter scoped(unfinished, 8);
+            scoped.write(values);
+        }
+        CHECK(unfinished.str() == expected.str());
+    }
+
+    TEST_CASE("Batch transforms map and filter")
+    {
+        std::string text;
+        for (int i = -50; i < 50; ++i)
+        {
+            text += std::to_string(i) + " 4\n";
+        }
+        text += "oops\n";
+        std::istringstream input(text);
+        std::ostringstream output;
+        FractionBatchTransform keepPositive = [](std::span<Fraction> batch)
+        {
+            std::size_t kept = 0;
+            for (const Fraction &value : batch)
+            {
+                if (value.getNumerator() > 0)
+                {
+                    batch[kept++] = value;
+                }
+            }
+            return kept;
+        };
+        FractionBatchTransform twice = [](std::span<Fraction> batch)
+        {
+            for (Fraction &value : batch)
+            {
+                value *= Fraction(2);
+            }
+            return batch.size();
+        };
+        FractionStreamStats stats = process_fraction_stream(input, output, {keepPositive, twice}, 7);
+        CHECK(stats.valuesRead == 100);
+        CHECK(stats.valuesWritten == 49);
+        CHECK(stats.errors == 1);
+        std::string result = output.str();
+        CHECK(result.substr(0, 10) == "1/2\n1/1\n3/");
+        CHECK(result.substr(result.size() - 5) == "49/2\n");
+    }
+}
@@ -0,0 +1,128 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionTable.hpp"
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+using namespace ariel;
+
+namespace
+{
+    std::string tablePath(const char *name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST_SUITE("Mapped fraction tables")
+{
+    TEST_CASE("32-bit table is viewed in place")
+    {
+        std::string path = tablePath("fraction_table_test_32.bin");
+        std::vector<Fraction> values{Fraction(-5, 2), Fraction(-1, 3), Fraction(), Fraction(1, 7), Fraction(std::numeric_limits<int>::max())};
+        write_fraction_table(path, values);
+        {
+            FractionTable table(path);
+            CHECK(table.size() == values.size());
+            CHECK(table.width() == 32);
+            CHECK(table.sorted());
+            CHECK(table.verify());
+            CHECK(table.flat()[1] == FlatFraction(-1, 3));
+            CHECK(table[3].getDenominator() == 7);
+            CHECK(table.find(Fraction(1, 7)) == 3);
+            CHECK_FALSE(table.find(Fraction(1, 8)).has_value());
+            CHECK_THROWS_AS(table[5], std::out_of_range);
+            CHECK_THROWS_AS(table.wide(), std::logic_error);
+        }
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("64-bit table and unsorted lookups")
+    {
+        std::string path = tablePath("fraction_table_test_64.bin");
+        std::vector<LongFraction> values{LongFraction(1, 2), LongFraction(-4000000000LL, 3), LongFraction(2, 9)};
+        write_fraction_table(path, values);
+        {
+            FractionTable table(path);
+            CHECK(table.width() == 64);
+            CHECK_FALSE(table.sorted());
+            CHECK(table.wide()[1].getNumerator() == -4000000000LL);
+            CHECK(table.find(Fraction(2, 9)) == 2);
+            CHECK(table[0].getDenominator() == 2);
+            CHECK_THROWS_AS(table[1], std::overflow_error);
+            CHECK_THROWS_AS(table.flat(), std::logic_error);
+        }
+        std::filesystem::remove(path);
+        CHECK_THROWS_AS(write_fraction_table(path, std::vector<Fraction>{}, 16), std::invalid_argument);
+    }
+
+    TEST_CASE("Invalid files are rejected")
+    {
+        std::string path = tablePath("fraction_table_test_bad.bin");
+        write_fraction_table(path, std::vector<Fraction>{Fraction(1, 2), Fraction(1, 3)});
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+        CHECK_THROWS_AS(FractionTable table(path), std::runtime_error);
+
+        {
+            std::ofstream output(path, std::ios::binary | std::ios::trunc);
+            output << "this is not a fraction table at all";
+        }
+        CHECK_THROWS_AS(FractionTable table(path), std::runtime_error);
+
+        write_fraction_table(path, std::vector<Fraction>{Fraction(1, 2), Fraction(1, 3)});
+        {
+            std::fstream output(path, std::ios::binary | std::ios::in | std::ios::out);
+            output.seekp(32);
+            output.put(9);
+        }
+        FractionTable damaged(path);
+        CHECK_FALSE(damaged.verify());
+        std::filesystem::remove(path);
+    }
+
+    TEST_CASE("Tampered elements are rejected when read")
+    {
+        std::string path = tablePath("fraction_table_test_tampered.bin");
+        for (unsigned width : {32U, 64U})
+        {
+            write_fraction_table(path, std::vector<Fraction>{Fraction(1, 2), Fraction(1, 3), Fraction(5, 7)}, width);
+            std::streamoff element = width / 4;
+            {
+                std::fstream output(path, std::ios::binary | std::ios::in | std::ios::out);
+                // zero denominator of element 0
+                output.seekp(32 + element / 2);
+                for (std::streamoff i = 0; i < element / 2; ++i)
+                {
+                    output.put(0);
+                }
+                // negative denominator of element 1
+                output.seekp(32 + element + element / 2);
+                for (std::streamoff i = 0; i < element / 2; ++i)
+                {
+                    output.put(static_cast<char>(0xff));
+                }
+                // 5/7 becomes the unreduced 14/7
+                output.seekp(32 + 2 * element);
+                output.put(14);
+            }
+            FractionTable table(path);
+            CHECK_THROWS_AS(table[0], std::runtime_error);
+            CHECK_THROWS_AS(table[1], std::runtime_error);
+            CHECK_THROWS_AS(table[2], std::runtime_error);
+            if (width == 32)
+            {
+                CHECK_FALSE(table.flat()[0].canonical());
+                CHECK_FALSE(table.flat()[2].canonical());
+            }
+            else
+            {
+                CHECK_FALSE(table.wide()[1].canonical());
+                CHECK_FALSE(table.wide()[2].canonical());
+            }
+        }
+        std::filesystem::remove(path);
+    }
+}
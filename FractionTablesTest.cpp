@@ -0,0 +1,58 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/FractionTables.hpp"
+#include <numeric>
+using namespace ariel;
+
+TEST_SUITE("Small value tables")
+{
+    TEST_CASE("Generated gcd table matches std::gcd")
+    {
+        bool allMatch = true;
+        for (unsigned left = 0; left < 256; ++left)
+        {
+            for (unsigned right = 0; right < 256; ++right)
+            {
+                allMatch = allMatch && DefaultSmallTables::gcdTable[left * 256 + right] == std::gcd(left, right);
+            }
+        }
+        CHECK(allMatch);
+        static_assert(SmallFractionTables<16>::gcdTable[12 * 16 + 8] == 4);
+    }
+
+    TEST_CASE("Table reduce matches division by the gcd")
+    {
+        bool allMatch = true;
+        for (int numerator = -255; numerator < 256; ++numerator)
+        {
+            for (int denominator = 1; denominator < 256; ++denominator)
+            {
+                int tableNumerator = numerator, tableDenominator = denominator;
+                int gcd = std::gcd(numerator, denominator);
+                allMatch = allMatch && DefaultSmallTables::reduce(tableNumerator, tableDenominator) &&
+                           tableNumerator == numerator / gcd && tableDenominator == denominator / gcd;
+            }
+        }
+        CHECK(allMatch);
+    }
+
+    TEST_CASE("Values outside of the tables are left to std::gcd")
+    {
+        int numerator = 512, denominator = 1024;
+        CHECK_FALSE(DefaultSmallTables::reduce(numerator, denominator));
+        CHECK(numerator == 512);
+        Fraction large(512, 1024);
+        CHECK(((large.getNumerator() == 1) && (large.getDenominator() == 2)));
+        Fraction small(-12, 18);
+        CHECK(((small.getNumerator() == -2) && (small.getDenominator() == 3)));
+        Fraction zero(0, 200);
+        CHECK(((zero.getNumerator() == 0) && (zero.getDenominator() == 1)));
+    }
+
+    TEST_CASE("Exact comparison of small values")
+    {
+        CHECK(DefaultSmallTables::compare(1, 255, 1, 254) < 0);
+        CHECK(DefaultSmallTables::compare(-2, 4, -1, 2) == 0);
+        CHECK(DefaultSmallTables::compare(3, 4, 2, 3) > 0);
+    }
+}
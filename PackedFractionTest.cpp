@@ -0,0 +1,60 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/PackedFraction.hpp"
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+using namespace ariel;
+
+TEST_SUITE("Packed fractions")
+{
+    TEST_CASE("CompactFraction round trips through Fraction")
+    {
+        Fraction original(-355, 113);
+        CompactFraction compact(original);
+        CHECK(compact.getNumerator() == -355);
+        CHECK(compact.getDenominator() == 113);
+        Fraction back = compact.toFraction();
+        CHECK(((back.getNumerator() == -355) && (back.getDenominator() == 113)));
+        CHECK(CompactFraction(6, -8) == CompactFraction(-3, 4));
+    }
+
+    TEST_CASE("Checked narrowing")
+    {
+        CHECK(CompactFraction::fits(Fraction(32767, 32767)));
+        CHECK_FALSE(CompactFraction::fits(Fraction(1, 40000)));
+        CHECK_THROWS_AS(CompactFraction(Fraction(40000, 3)), std::overflow_error);
+        CHECK_THROWS_AS(CompactFraction(40000, 3), std::overflow_error);
+        CHECK(CompactFraction(40000, 20000) == CompactFraction(2, 1));
+        CHECK_THROWS_AS(CompactFraction(1, 0), std::invalid_argument);
+
+        int max_int = std::numeric_limits<int>::max();
+        LongFraction big(Fraction(max_int, 1));
+        LongFraction square = big * big;
+        CHECK(square.getNumerator() == (std::int64_t)max_int * max_int);
+        CHECK_THROWS_AS(square.toFraction(), std::overflow_error);
+        CHECK((square / big).toFraction().getNumerator() == max_int);
+    }
+
+    TEST_CASE("Arithmetic narrows the reduced result on store")
+    {
+        CompactFraction a(200, 301), b(301, 200);
+        CompactFraction product = a * b;
+        CHECK(((product.getNumerator() == 1) && (product.getDenominator() == 1)));
+        CHECK_THROWS_AS(a + b, std::overflow_error);
+        CompactFraction sum = CompactFraction(1, 6) + CompactFraction(1, 3);
+        CHECK(sum == CompactFraction(1, 2));
+        CHECK((CompactFraction(1, 2) - CompactFraction(3, 4)) == CompactFraction(-1, 4));
+        CHECK_THROWS_AS(a / CompactFraction(), std::runtime_error);
+    }
+
+    TEST_CASE("Exact comparisons and printing")
+    {
+        CHECK(CompactFraction(1, 255) < CompactFraction(1, 254));
+        CHECK(LongFraction(-1, 3) <= LongFraction(-1, 3));
+        CHECK(LongFraction(2, 3) > LongFraction(3, 5));
+        std::stringstream output;
+        output << CompactFraction(-4, 6) << " " << LongFraction(10, 4);
+        CHECK(output.str() == "-2/3 5/2");
+    }
+}
@@ -0,0 +1,102 @@
+#include "doctest.h"
+#include "sources/Fraction.hpp"
+#include "sources/ShardedFractionSum.hpp"
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+using namespace ariel;
+
+TEST_SUITE("Sharded fraction sums")
+{
+    TEST_CASE("Shards do not share cache lines")
+    {
+        static_assert(alignof(FractionShard) == CACHE_LINE_SIZE);
+        static_assert(sizeof(FractionShard) % CACHE_LINE_SIZE == 0);
+        ShardedFractionSum sum(3);
+        CHECK(sum.size() == 3);
+        CHECK(reinterpret_cast<std::uintptr_t>(&sum.shard(1)) % CACHE_LINE_SIZE == 0);
+        CHECK_THROWS_AS(sum.shard(3), std::out_of_range);
+        CHECK(ShardedFractionSum().size() >= 1);
+    }
+
+    TEST_CASE("Total is exact and independent of the shard assignment")
+    {
+        std::vector<Fraction> values;
+        for (int i = 1; i <= 200; ++i)
+        {
+            values.emplace_back(i % 2 == 0 ? i : -i, i % 10 + 1);
+        }
+        WideRational expected;
+        for (const Fraction &value : values)
+        {
+            expected.accumulate(WideRational::of(value));
+        }
+        expected.reduce();
+        for (std::size_t shards : {1U, 2U, 7U})
+        {
+            ShardedFractionSum sum(shards);
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                sum.shard((i * 31) % shards).add(values[i]);
+            }
+            WideRational total = sum.collectWide();
+            CHECK(total.numerator == expected.numerator);
+            CHECK(total.denominator == expected.denominator);
+            sum.reset();
+            sum.shard(shards - 1).add(values);
+            CHECK(sum.collectWide().numerator == expected.numerator);
+        }
+    }
+
+    TEST_CASE("Partial sums may exceed int as long as the total fits")
+    {
+        int max_int = std::numeric_limits<int>::max();
+        ShardedFractionSum sum(2);
+        for (int i = 0; i < 4; ++i)
+        {
+            sum.shard(0).add(Fraction(max_int, 1));
+            sum.shard(1).add(Fraction(-max_int, 1));
+        }
+        sum.shard(1).add(Fraction(1, 3));
+        CHECK(sum.collect().getNumerator() == 1);
+        CHECK(sum.collect().getDenominator() == 3);
+        sum.shard(0).add(Fraction(max_int, 1));
+        CHECK_THROWS_AS(sum.collect(), std::overflow_error);
+        CHECK(sum.collectWide().numerator == WideRational{max_int, 1}.numerator * 3 + 1);
+    }
+
+    TEST_CASE("Concurrent additions give the same total on every run")
+    {
+        Fraction first;
+        for (int run = 0; run < 3; ++run)
+        {
+            ShardedFractionSum sum(4);
+            std::vector<std::thread> threads;
+            for (std::size_t thread = 0; thread < 4; ++thread)
+            {
+                threads.emplace_back([&sum, thread]()
+                                     {
+                    FractionShard &shard = sum.shard(thread);
+                    for (int i = 1; i <= 3000; ++i)
+                    {
+                        shard.add(Fraction(1, i % 12 + 1));
+                    } });
+            }
+            for (std::thread &thread : threads)
+            {
+                thread.join();
+            }
+            Fraction total = sum.collect();
+            if (run == 0)
+            {
+                first = total;
+            }
+            CHECK(total.getNumerator() == first.getNumerator());
+            CHECK(total.getDenominator() == first.getDenominator());
+        }
+        CHECK(first.getNumerator() == 2150525);
+        CHECK(first.getDenominator() == 693);
+    }
+}
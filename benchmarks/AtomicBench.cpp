@@ -0,0 +1,87 @@
+#include "AtomicFraction.hpp"
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "ShardedFractionSum.hpp"
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t ADDITION_COUNT = 1 << 18;
+
+    /// run count additions split evenly over threads, add is called with the thread and the index of the addition
+    template <typename Add>
+    void contend(std::size_t count, unsigned threads, Add add)
+    {
+        std::vector<std::thread> pool;
+        for (unsigned thread = 0; thread < threads; ++thread)
+        {
+            pool.emplace_back([&add, count, threads, thread]()
+                              {
+                for (std::size_t index = 0; index < count / threads; ++index)
+                {
+                    add(thread, index);
+                } });
+        }
+        for (std::thread &thread : pool)
+        {
+            thread.join();
+        }
+    }
+
+    /// the deltas share a few small denominators, like the per-event amounts of a counter
+    Fraction delta(std::size_t index)
+    {
+        return Fraction(1, static_cast<int>(index % 4) + 1);
+    }
+
+    const bool registered = []()
+    {
+        for (unsigned threads : {1U, 2U, 8U, 64U})
+        {
+            std::string suffix = " " + std::to_string(threads) + " threads";
+            bench::Registrar("atomic/mutex operator+=" + suffix, ADDITION_COUNT, [threads](std::size_t iterations)
+                             {
+                std::mutex mutex;
+                Fraction total;
+                contend(iterations, threads, [&mutex, &total](unsigned /*thread*/, std::size_t index)
+                        {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    total += delta(index);
+                    // keep the sum bounded, 25/12 is the sum of one round of deltas
+                    if (index % 4 == 3)
+                    {
+                        total -= Fraction(25, 12);
+                    } });
+                bench::doNotOptimize(total); });
+            bench::Registrar("atomic/AtomicFraction fetch_add" + suffix, ADDITION_COUNT, [threads](std::size_t iterations)
+                             {
+                ariel::AtomicFraction total;
+                contend(iterations, threads, [&total](unsigned /*thread*/, std::size_t index)
+                        {
+                    total.fetch_add(delta(index));
+                    if (index % 4 == 3)
+                    {
+                        total.fetch_sub(Fraction(25, 12));
+                    } });
+                bench::doNotOptimize(total.load()); });
+            bench::Registrar("atomic/ShardedFractionSum add" + suffix, ADDITION_COUNT, [threads](std::size_t iterations)
+                             {
+                ariel::ShardedFractionSum total(threads);
+                contend(iterations, threads, [&total](unsigned thread, std::size_t index)
+                        {
+                    ariel::FractionShard &shard = total.shard(thread);
+                    shard.add(delta(index));
+                    if (index % 4 == 3)
+                    {
+                        shard.add(Fraction(-25, 12));
+                    } });
+                bench::doNotOptimize(total.collect()); });
+        }
+        return true;
+    }();
+}
@@ -0,0 +1,451 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// the subset of JSON written by the benchmark binary: objects, arrays, strings, numbers and literals
+    struct JsonValue
+    {
+        enum class Kind
+        {
+            null,
+            boolean,
+            number,
+            string,
+            array,
+            object
+        };
+
+        Kind kind = Kind::null;
+        double number = 0;
+        std::string text;
+        std::vector<JsonValue> items;
+        std::map<std::string, JsonValue> members;
+
+        const JsonValue *member(const std::string &name) const
+        {
+            auto found = members.find(name);
+            return found == members.end() ? nullptr : &found->second;
+        }
+    };
+
+    class JsonParser
+    {
+    private:
+        const std::string &input;
+        std::size_t position = 0;
+
+        [[noreturn]] void fail(const std::string &message) const
+        {
+            throw std::runtime_error(message + " at offset " + std::to_string(position));
+        }
+
+        void skipBlanks()
+        {
+            while (position < input.size() && std::isspace(static_cast<unsigned char>(input[position])) != 0)
+            {
+                ++position;
+            }
+        }
+
+        bool consume(char expected)
+        {
+            skipBlanks();
+            if (position < input.size() && input[position] == expected)
+            {
+                ++position;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char expected)
+        {
+            if (!consume(expected))
+            {
+                fail(std::string("expected '") + expected + "'");
+            }
+        }
+
+        std::string parseString()
+        {
+            expect('"');
+            std::string text;
+            while (position < input.size() && input[position] != '"')
+            {
+                char character = input[position++];
+                if (character == '\\')
+                {
+                    if (position == input.size())
+                    {
+                        break;
+                    }
+                    char escaped = input[position++];
+                    const std::string from = "nrtbf";
+                    const std::string to = "\n\r\t\b\f";
+                    std::size_t index = from.find(escaped);
+                    character = index == std::string::npos ? escaped : to[index];
+                }
+                text += character;
+            }
+            expect('"');
+            return text;
+        }
+
+    public:
+        explicit JsonParser(const std::string &text) : input(text) {}
+
+        JsonValue parse()
+        {
+            JsonValue value = parseValue();
+            skipBlanks();
+            if (position != input.size())
+            {
+                fail("unexpected trailing text");
+            }
+            return value;
+        }
+
+        JsonValue parseValue()
+        {
+            skipBlanks();
+            if (position == input.size())
+            {
+                fail("unexpected end of input");
+            }
+            JsonValue value;
+            char first = input[position];
+            if (first == '{')
+            {
+                value.kind = JsonValue::Kind::object;
+                ++position;
+                if (!consume('}'))
+                {
+                    do
+                    {
+                        skipBlanks();
+                        std::string name = parseString();
+                        expect(':');
+                        value.members[name] = parseValue();
+                    } while (consume(','));
+                    expect('}');
+                }
+            }
+            else if (first == '[')
+            {
+                value.kind = JsonValue::Kind::array;
+                ++position;
+                if (!consume(']'))
+                {
+                    do
+                    {
+                        value.items.push_back(parseValue());
+                    } while (consume(','));
+                    expect(']');
+                }
+            }
+            else if (first == '"')
+            {
+                value.kind = JsonValue::Kind::string;
+                value.text = parseString();
+            }
+            else if (input.compare(position, 4, "true") == 0 || input.compare(position, 5, "false") == 0)
+            {
+                value.kind = JsonValue::Kind::boolean;
+                value.number = first == 't' ? 1 : 0;
+                position += first == 't' ? 4 : 5;
+            }
+            else if (input.compare(position, 4, "null") == 0)
+            {
+                position += 4;
+            }
+            else
+            {
+                const char *start = input.c_str() + position;
+                char *end = nullptr;
+                value.kind = JsonValue::Kind::number;
+                value.number = std::strtod(start, &end);
+                if (end == start)
+                {
+                    fail("invalid value");
+                }
+                position += static_cast<std::size_t>(end - start);
+            }
+            return value;
+        }
+    };
+
+    /// samples of one benchmark, in ns per iteration
+    struct Samples
+    {
+        std::vector<double> values;
+        double median = 0;
+    };
+
+    using ResultSet = std::map<std::string, Samples>;
+
+    double medianOf(std::vector<double> values)
+    {
+        std::sort(values.begin(), values.end());
+        std::size_t middle = values.size() / 2;
+        return values.size() % 2 == 1 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+    }
+
+    ResultSet load(const std::string &path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("cannot read " + path);
+        }
+        std::stringstream text;
+        text << file.rdbuf();
+        std::string content = text.str();
+        JsonValue root = JsonParser(content).parse();
+        const JsonValue *benchmarks = root.member("benchmarks");
+        if (benchmarks == nullptr || benchmarks->kind != JsonValue::Kind::array)
+        {
+            throw std::runtime_error(path + " has no benchmarks array");
+        }
+        ResultSet results;
+        for (const JsonValue &benchmark : benchmarks->items)
+        {
+            const JsonValue *name = benchmark.member("name");
+            const JsonValue *samples = benchmark.member("samples");
+            if (name == nullptr || samples == nullptr || samples->items.empty())
+            {
+                throw std::runtime_error(path + " has a benchmark without name or samples");
+            }
+            Samples &entry = results[name->text];
+            for (const JsonValue &sample : samples->items)
+            {
+                entry.values.push_back(sample.number);
+            }
+            entry.median = medianOf(entry.values);
+        }
+        return results;
+    }
+
+    /// one sided Mann-Whitney U test
+    /// @return p-value of the hypothesis that candidate samples tend to be larger than baseline samples
+    double mannWhitneyGreater(const std::vector<double> &baseline, const std::vector<double> &candidate)
+    {
+        std::size_t baselineCount = baseline.size();
+        std::size_t candidateCount = candidate.size();
+        std::vector<std::pair<double, bool>> pooled;
+        for (double value : baseline)
+        {
+            pooled.emplace_back(value, false);
+        }
+        for (double value : candidate)
+        {
+            pooled.emplace_back(value, true);
+        }
+        std::sort(pooled.begin(), pooled.end());
+
+        // average ranks over ties, tieTerm is the sum of t^3 - t over tie groups
+        double candidateRankSum = 0;
+        double tieTerm = 0;
+        for (std::size_t first = 0; first < pooled.size();)
+        {
+            std::size_t last = first;
+            while (last + 1 < pooled.size() && pooled[last + 1].first == pooled[first].first)
+            {
+                ++last;
+            }
+            double rank = static_cast<double>(first + last) / 2 + 1;
+            for (std::size_t index = first; index <= last; ++index)
+            {
+                candidateRankSum += pooled[index].second ? rank : 0;
+            }
+            auto ties = static_cast<double>(last - first + 1);
+            tieTerm += ties * ties * ties - ties;
+            first = last + 1;
+        }
+        double u = candidateRankSum - static_cast<double>(candidateCount * (candidateCount + 1)) / 2;
+
+        if (baselineCount * candidateCount <= 2500)
+        {
+            // exact null distribution: ways[k][u] counts the arrangements of k candidate and the first baseline
+            // samples with statistic u, built one baseline sample at a time
+            std::size_t maxU = baselineCount * candidateCount;
+            std::vector<std::vector<double>> ways(candidateCount + 1, std::vector<double>(maxU + 1, 0));
+            for (std::size_t k = 0; k <= candidateCount; ++k)
+            {
+                ways[k][0] = 1;
+            }
+            for (std::size_t baselineUsed = 1; baselineUsed <= baselineCount; ++baselineUsed)
+            {
+                std::vector<std::vector<double>> next(candidateCount + 1, std::vector<double>(maxU + 1, 0));
+                next[0][0] = 1;
+                for (std::size_t k = 1; k <= candidateCount; ++k)
+                {
+                    for (std::size_t value = 0; value <= maxU; ++value)
+                    {
+                        // the largest sample is either a baseline one (u unchanged) or a candidate one beating every baseline sample
+                        next[k][value] = ways[k][value] + (value >= baselineUsed ? next[k - 1][value - baselineUsed] : 0);
+                    }
+                }
+                ways = std::move(next);
+            }
+            double total = 0;
+            double tail = 0;
+            for (std::size_t value = 0; value <= maxU; ++value)
+            {
+                total += ways[candidateCount][value];
+                tail += static_cast<double>(value) >= u - 1e-9 ? ways[candidateCount][value] : 0;
+            }
+            return tail / total;
+        }
+
+        // normal approximation with tie and continuity corrections
+        auto sizes = static_cast<double>(baselineCount + candidateCount);
+        double mean = static_cast<double>(baselineCount * candidateCount) / 2;
+        double variance = static_cast<double>(baselineCount * candidateCount) / 12 * ((sizes + 1) - tieTerm / (sizes * (sizes - 1)));
+        if (variance <= 0)
+        {
+            return 1;
+        }
+        double z = (u - mean - 0.5) / std::sqrt(variance);
+        return 0.5 * std::erfc(z / std::sqrt(2.0));
+    }
+
+    struct Options
+    {
+        double thresholdPercent = 5;
+        double alpha = 0.05;
+        std::string filter;
+        std::string baselinePath;
+        std::string candidatePath;
+    };
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        std::vector<std::string> arguments(argv + 1, argv + argc);
+        std::vector<std::string> paths;
+        for (std::size_t index = 0; index < arguments.size(); ++index)
+        {
+            const std::string &argument = arguments[index];
+            bool hasValue = index + 1 < arguments.size();
+            if (argument == "--threshold" && hasValue)
+            {
+                options.thresholdPercent = std::atof(arguments[++index].c_str());
+            }
+            else if (argument == "--alpha" && hasValue)
+            {
+                options.alpha = std::atof(arguments[++index].c_str());
+            }
+            else if (argument == "--filter" && hasValue)
+            {
+                options.filter = arguments[++index];
+            }
+            else if (argument.rfind("--", 0) == 0)
+            {
+                return false;
+            }
+            else
+            {
+                paths.push_back(argument);
+            }
+        }
+        if (paths.size() != 2 || options.thresholdPercent < 0 || options.alpha <= 0 || options.alpha >= 1)
+        {
+            return false;
+        }
+        options.baselinePath = paths[0];
+        options.candidatePath = paths[1];
+        return true;
+    }
+}
+
+/// Compares two result files of bench --json. A benchmark regresses if its candidate median is more
+/// than --threshold percent (default 5) above the baseline median and a one sided Mann-Whitney test on
+/// the samples rejects "not slower" at level --alpha (default 0.05). Prints a table of every benchmark
+/// in both files and exits with 1 if any regressed, 2 on bad arguments or unreadable files.
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "usage: " << argv[0] << " [--threshold PERCENT] [--alpha P] [--filter TEXT] BASELINE.json CANDIDATE.json" << std::endl;
+        return 2;
+    }
+    ResultSet baseline;
+    ResultSet candidate;
+    try
+    {
+        baseline = load(options.baselinePath);
+        candidate = load(options.candidatePath);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+
+    std::size_t nameWidth = 9;
+    for (const auto &[name, samples] : candidate)
+    {
+        nameWidth = std::max(nameWidth, name.size());
+    }
+    std::cout << std::left << std::setw(static_cast<int>(nameWidth)) << "benchmark" << std::right << std::setw(14) << "baseline ns" << std::setw(14)
+              << "candidate ns" << std::setw(10) << "change" << std::setw(10) << "p-value" << "  verdict\n";
+    std::cout << std::fixed;
+    int regressions = 0;
+    for (const auto &[name, samples] : candidate)
+    {
+        if (name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+        auto found = baseline.find(name);
+        std::cout << std::left << std::setw(static_cast<int>(nameWidth)) << name << std::right;
+        if (found == baseline.end())
+        {
+            std::cout << std::setw(14) << "-" << std::setw(14) << std::setprecision(2) << samples.median << std::setw(10) << "-" << std::setw(10)
+                      << "-" << "  new\n";
+            continue;
+        }
+        const Samples &before = found->second;
+        double change = (samples.median - before.median) / before.median * 100;
+        double slower = mannWhitneyGreater(before.values, samples.values);
+        double faster = mannWhitneyGreater(samples.values, before.values);
+        std::string verdict = "same";
+        double pValue = std::min(slower, faster);
+        if (change > options.thresholdPercent && slower < options.alpha)
+        {
+            verdict = "REGRESSION";
+            pValue = slower;
+            ++regressions;
+        }
+        else if (change < -options.thresholdPercent && faster < options.alpha)
+        {
+            verdict = "improved";
+            pValue = faster;
+        }
+        std::ostringstream percent;
+        percent << std::showpos << std::fixed << std::setprecision(1) << change << "%";
+        std::cout << std::setw(14) << std::setprecision(2) << before.median << std::setw(14) << samples.median << std::setw(10) << percent.str()
+                  << std::setw(10) << std::setprecision(4) << pValue << "  " << verdict << "\n";
+    }
+    for (const auto &[name, samples] : baseline)
+    {
+        if (name.find(options.filter) != std::string::npos && candidate.find(name) == candidate.end())
+        {
+            std::cout << std::left << std::setw(static_cast<int>(nameWidth)) << name << std::right << std::setw(14) << std::setprecision(2)
+                      << samples.median << std::setw(14) << "-" << std::setw(10) << "-" << std::setw(10) << "-" << "  missing\n";
+        }
+    }
+    std::cout << regressions << " regression" << (regressions == 1 ? "" : "s") << std::endl;
+    return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    /// @brief a registered micro-benchmark, body runs the measured operation the given number of times
+    struct Benchmark
+    {
+        std::string name;
+        std::size_t iterations;
+        std::function<void(std::size_t)> body;
+    };
+
+    /// @brief all benchmarks registered by the benchmark translation units
+    /// @return reference to the global registry
+    std::vector<Benchmark> &registry();
+
+    /// @brief registers a benchmark from a static initializer
+    struct Registrar
+    {
+        Registrar(std::string name, std::size_t iterations, std::function<void(std::size_t)> body)
+        {
+            registry().push_back(Benchmark{std::move(name), iterations, std::move(body)});
+        }
+    };
+
+    /// @brief keep the compiler from optimizing away a computed value
+    /// @param value the value that must be materialized
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+}
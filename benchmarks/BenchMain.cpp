@@ -0,0 +1,271 @@
+#include "BenchHarness.hpp"
+#include "PerfCounters.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    std::vector<Benchmark> &registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+}
+
+namespace
+{
+    /// command line of the benchmark binary
+    struct Options
+    {
+        std::string filter;
+        std::string jsonPath;
+        int warmupRuns = 1;
+        int measuredRuns = 5;
+        bool counters = false;
+    };
+
+    /// summary of the measured runs of one benchmark, in ns per iteration
+    struct Result
+    {
+        const bench::Benchmark *benchmark = nullptr;
+        std::vector<double> samples;
+        double median = 0;
+        double p10 = 0;
+        double p90 = 0;
+        double mean = 0;
+        /// hardware counts per iteration over the measured runs, only meaningful if counted
+        bench::PerfCounters::Sample counts;
+        bool counted = false;
+    };
+
+    /// run the body once, adding its hardware counts to total if counters is not null
+    double runOnce(const bench::Benchmark &benchmark, bench::PerfCounters *counters, bench::PerfCounters::Sample &total)
+    {
+        if (counters != nullptr)
+        {
+            counters->start();
+        }
+        auto start = std::chrono::steady_clock::now();
+        benchmark.body(benchmark.iterations);
+        auto end = std::chrono::steady_clock::now();
+        if (counters != nullptr)
+        {
+            bench::PerfCounters::Sample sample = counters->stop();
+            for (std::size_t event = 0; event < sample.values.size(); ++event)
+            {
+                total.values[event] += sample.values[event];
+            }
+        }
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(benchmark.iterations);
+    }
+
+    /// percentile of sorted samples with linear interpolation between the closest ranks
+    double percentile(const std::vector<double> &sorted, double fraction)
+    {
+        double rank = fraction * static_cast<double>(sorted.size() - 1);
+        auto lower = static_cast<std::size_t>(std::floor(rank));
+        std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - static_cast<double>(lower));
+    }
+
+    Result measure(const bench::Benchmark &benchmark, const Options &options, bench::PerfCounters *counters)
+    {
+        Result result;
+        result.benchmark = &benchmark;
+        bench::PerfCounters::Sample ignored;
+        for (int run = 0; run < options.warmupRuns; ++run)
+        {
+            runOnce(benchmark, nullptr, ignored);
+        }
+        for (int run = 0; run < options.measuredRuns; ++run)
+        {
+            result.samples.push_back(runOnce(benchmark, counters, result.counts));
+        }
+        if (counters != nullptr)
+        {
+            result.counted = true;
+            for (double &count : result.counts.values)
+            {
+                count /= static_cast<double>(benchmark.iterations) * options.measuredRuns;
+            }
+        }
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+        result.median = percentile(sorted, 0.5);
+        result.p10 = percentile(sorted, 0.1);
+        result.p90 = percentile(sorted, 0.9);
+        for (double sample : sorted)
+        {
+            result.mean += sample / static_cast<double>(sorted.size());
+        }
+        return result;
+    }
+
+    std::string jsonString(const std::string &text)
+    {
+        std::string quoted = "\"";
+        for (char character : text)
+        {
+            if (character == '"' || character == '\\')
+            {
+                quoted += '\\';
+            }
+            quoted += character;
+        }
+        return quoted + "\"";
+    }
+
+    /// hardware counts per iteration as "name": value pairs, instructions per cycle included if both are counted
+    std::vector<std::pair<std::string, double>> counterFields(const Result &result, const bench::PerfCounters &counters)
+    {
+        using bench::PerfCounters;
+        std::vector<std::pair<std::string, double>> fields;
+        if (counters.available(PerfCounters::cycles) && counters.available(PerfCounters::instructions) && result.counts.values[PerfCounters::cycles] > 0)
+        {
+            fields.emplace_back("ipc", result.counts.values[PerfCounters::instructions] / result.counts.values[PerfCounters::cycles]);
+        }
+        for (int event = 0; event < PerfCounters::eventCount; ++event)
+        {
+            auto counted = static_cast<PerfCounters::Event>(event);
+            if (counters.available(counted))
+            {
+                fields.emplace_back(PerfCounters::name(counted), result.counts.values[counted]);
+            }
+        }
+        return fields;
+    }
+
+    /// write the results as {"unit": "ns", "benchmarks": [{"name", "iterations", "median", "p10", "p90", "mean", "samples"}]},
+    /// with a "counters" object of per iteration hardware counts when they were read
+    void writeJson(std::ostream &output, const std::vector<Result> &results, const bench::PerfCounters *counters)
+    {
+        output.precision(17);
+        output << "{\n  \"unit\": \"ns\",\n  \"benchmarks\": [";
+        for (std::size_t index = 0; index < results.size(); ++index)
+        {
+            const Result &result = results[index];
+            output << (index == 0 ? "\n" : ",\n") << "    {\"name\": " << jsonString(result.benchmark->name)
+                   << ", \"iterations\": " << result.benchmark->iterations << ", \"median\": " << result.median << ", \"p10\": " << result.p10
+                   << ", \"p90\": " << result.p90 << ", \"mean\": " << result.mean << ", \"samples\": [";
+            for (std::size_t sample = 0; sample < result.samples.size(); ++sample)
+            {
+                output << (sample == 0 ? "" : ", ") << result.samples[sample];
+            }
+            output << "]";
+            if (result.counted && counters != nullptr && counters->anyAvailable())
+            {
+                output << ", \"counters\": {";
+                std::vector<std::pair<std::string, double>> fields = counterFields(result, *counters);
+                for (std::size_t field = 0; field < fields.size(); ++field)
+                {
+                    output << (field == 0 ? "" : ", ") << jsonString(fields[field].first) << ": " << fields[field].second;
+                }
+                output << "}";
+            }
+            output << "}";
+        }
+        output << "\n  ]\n}\n";
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        std::vector<std::string> arguments(argv + 1, argv + argc);
+        for (std::size_t index = 0; index < arguments.size(); ++index)
+        {
+            const std::string &argument = arguments[index];
+            bool hasValue = index + 1 < arguments.size();
+            if (argument == "--json" && hasValue)
+            {
+                options.jsonPath = arguments[++index];
+            }
+            else if ((argument == "--repetitions" || argument == "--warmup") && hasValue)
+            {
+                int count = std::atoi(arguments[++index].c_str());
+                if (count < (argument == "--warmup" ? 0 : 1))
+                {
+                    return false;
+                }
+                (argument == "--warmup" ? options.warmupRuns : options.measuredRuns) = count;
+            }
+            else if (argument == "--counters")
+            {
+                options.counters = true;
+            }
+            else if (argument.rfind("--", 0) == 0 || !options.filter.empty())
+            {
+                return false;
+            }
+            else
+            {
+                options.filter = argument;
+            }
+        }
+        return true;
+    }
+}
+
+/// Runs every registered benchmark whose name contains the optional filter argument and prints the
+/// median, 10th and 90th percentile time per iteration. --json PATH also writes every sample to PATH,
+/// --repetitions N and --warmup N set the number of measured and discarded runs. --counters adds the
+/// hardware counts per iteration, summed over the threads a benchmark starts, and the instructions per
+/// cycle of the measured runs, when the machine and the kernel allow reading them.
+int main(int argc, char **argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::cerr << "usage: " << argv[0] << " [--json PATH] [--repetitions N] [--warmup N] [--counters] [FILTER]" << std::endl;
+        return 2;
+    }
+    std::unique_ptr<bench::PerfCounters> counters;
+    if (options.counters)
+    {
+        counters = std::make_unique<bench::PerfCounters>();
+        if (!counters->anyAvailable())
+        {
+            std::cerr << "hardware counters unavailable (" << counters->unavailableReason() << "), reporting time only" << std::endl;
+            counters.reset();
+        }
+        else if (!counters->unavailableReason().empty())
+        {
+            std::cerr << "some hardware counters unavailable (" << counters->unavailableReason() << ")" << std::endl;
+        }
+    }
+    std::vector<Result> results;
+    for (const bench::Benchmark &benchmark : bench::registry())
+    {
+        if (benchmark.name.find(options.filter) == std::string::npos)
+        {
+            continue;
+        }
+        results.push_back(measure(benchmark, options, counters.get()));
+        const Result &result = results.back();
+        std::cout << benchmark.name << ": " << result.median << " ns/iteration (p10 " << result.p10 << ", p90 " << result.p90 << ")";
+        if (counters)
+        {
+            for (const auto &[name, value] : counterFields(result, *counters))
+            {
+                std::cout << " " << value << " " << name;
+            }
+        }
+        std::cout << std::endl;
+    }
+    if (!options.jsonPath.empty())
+    {
+        std::ofstream output(options.jsonPath);
+        writeJson(output, results, counters.get());
+        if (!output)
+        {
+            std::cerr << "cannot write " << options.jsonPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
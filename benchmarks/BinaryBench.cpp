@@ -0,0 +1,92 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionBinary.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t VALUE_COUNT = 4096;
+
+    std::vector<Fraction> makeValues()
+    {
+        std::mt19937 generator(43);
+        std::uniform_int_distribution<int> numerators(-100000, 100000);
+        std::uniform_int_distribution<int> denominators(1, 1000);
+        std::vector<Fraction> values;
+        for (std::size_t i = 0; i < VALUE_COUNT; ++i)
+        {
+            values.emplace_back(numerators(generator), i % 4 == 0 ? 1 : denominators(generator));
+        }
+        return values;
+    }
+
+    const std::vector<Fraction> values = makeValues();
+
+    std::string textColumn()
+    {
+        std::ostringstream output;
+        for (const Fraction &value : values)
+        {
+            output << value.getNumerator() << " " << value.getDenominator() << "\n";
+        }
+        return output.str();
+    }
+
+    std::string binaryColumn()
+    {
+        std::ostringstream output;
+        ariel::write_fraction_column(output, values);
+        return output.str();
+    }
+
+    const std::string text = textColumn();
+    const std::string binary = binaryColumn();
+
+    bench::Registrar textSave("binary/save as text with operator<<", 50, [](std::size_t iterations)
+                              {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::ostringstream output;
+            for (const Fraction &value : values)
+            {
+                output << value << "\n";
+            }
+            bench::doNotOptimize(output.tellp());
+        } });
+
+    bench::Registrar binarySave("binary/save with write_fraction_column", 50, [](std::size_t iterations)
+                                {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::ostringstream output;
+            ariel::write_fraction_column(output, values);
+            bench::doNotOptimize(output.tellp());
+        } });
+
+    bench::Registrar textLoad("binary/load text with operator>>", 50, [](std::size_t iterations)
+                              {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::istringstream input(text);
+            std::vector<Fraction> loaded(VALUE_COUNT);
+            for (Fraction &value : loaded)
+            {
+                input >> value;
+            }
+            bench::doNotOptimize(loaded.back());
+        } });
+
+    bench::Registrar binaryLoad("binary/load with read_fraction_column", 50, [](std::size_t iterations)
+                                {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::istringstream input(binary);
+            std::vector<Fraction> loaded = ariel::read_fraction_column(input);
+            bench::doNotOptimize(loaded.back());
+        } });
+}
@@ -0,0 +1,80 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include <random>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t SERIES_LENGTH = 1024;
+
+    /// small positive and negative values with power of two denominators so the sums never overflow
+    std::vector<Fraction> makeSeries()
+    {
+        std::mt19937 generator(3);
+        std::uniform_int_distribution<int> exponent(0, 6);
+        std::vector<Fraction> values;
+        for (std::size_t i = 0; i < SERIES_LENGTH; ++i)
+        {
+            int denominator = 1 << exponent(generator);
+            std::uniform_int_distribution<int> numerator(-denominator, denominator);
+            values.emplace_back(numerator(generator), denominator);
+        }
+        return values;
+    }
+
+    const std::vector<Fraction> series = makeSeries();
+
+    bench::Registrar accumulateAdd("compound/sum += x", 500, [](std::size_t iterations)
+                                   {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Fraction sum;
+            for (const Fraction &value : series)
+            {
+                sum += value;
+            }
+            bench::doNotOptimize(sum);
+        } });
+
+    bench::Registrar accumulateAddFloat("compound/sum += 0.5f", 500, [](std::size_t iterations)
+                                        {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Fraction sum;
+            for (std::size_t i = 0; i < SERIES_LENGTH; ++i)
+            {
+                sum += 0.5F;
+            }
+            bench::doNotOptimize(sum);
+        } });
+
+    bench::Registrar accumulateMul("compound/product *= x / x", 500, [](std::size_t iterations)
+                                   {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Fraction product(1);
+            for (const Fraction &value : series)
+            {
+                if (value.getNumerator() != 0)
+                {
+                    product *= value;
+                    product /= value;
+                }
+            }
+            bench::doNotOptimize(product);
+        } });
+
+    bench::Registrar binaryAdd("compound/sum = sum + x", 500, [](std::size_t iterations)
+                               {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Fraction sum;
+            for (const Fraction &value : series)
+            {
+                sum = sum + value;
+            }
+            bench::doNotOptimize(sum);
+        } });
+}
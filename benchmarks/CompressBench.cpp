@@ -0,0 +1,69 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionBinary.hpp"
+#include "FractionCompress.hpp"
+#include "FractionSort.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t VALUE_COUNT = 1 << 16;
+
+    /// sorted column of prices with a handful of denominators
+    std::vector<Fraction> makeValues()
+    {
+        std::mt19937 generator(53);
+        std::uniform_int_distribution<int> numerators(0, 10000000);
+        std::vector<int> denominators{100, 100, 100, 1000, 8};
+        std::uniform_int_distribution<std::size_t> pick(0, denominators.size() - 1);
+        std::vector<Fraction> values;
+        for (std::size_t i = 0; i < VALUE_COUNT; ++i)
+        {
+            values.emplace_back(numerators(generator), denominators[pick(generator)]);
+        }
+        ariel::sort_fractions(values, 1);
+        return values;
+    }
+
+    const std::vector<Fraction> values = makeValues();
+    const ariel::CompressedFractionColumn column(values);
+
+    std::string binaryColumn()
+    {
+        std::ostringstream output;
+        ariel::write_fraction_column(output, values);
+        return output.str();
+    }
+
+    const std::string binary = binaryColumn();
+
+    bench::Registrar varintDecode("compress/read_fraction_column varint records", 20, [](std::size_t iterations)
+                                  {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::istringstream input(binary);
+            std::vector<Fraction> decoded = ariel::read_fraction_column(input);
+            bench::doNotOptimize(decoded.back());
+        } });
+
+    bench::Registrar blockDecode("compress/CompressedFractionColumn::decode", 20, [](std::size_t iterations)
+                                 {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::vector<Fraction> decoded = column.decode();
+            bench::doNotOptimize(decoded.back());
+        } });
+
+    bench::Registrar blockEncode("compress/CompressedFractionColumn encode", 20, [](std::size_t iterations)
+                                 {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            ariel::CompressedFractionColumn encoded(values);
+            bench::doNotOptimize(encoded.compressedBytes());
+        } });
+}
@@ -0,0 +1,69 @@
+#include "BenchHarness.hpp"
+#include "DecimalFraction.hpp"
+#include "Fraction.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ariel::DecimalFraction;
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t TEXT_COUNT = 4096;
+
+    std::vector<std::string> makeTexts()
+    {
+        std::mt19937 generator(17);
+        std::uniform_int_distribution<long long> millis(-1000, 1000);
+        std::vector<std::string> texts;
+        for (std::size_t i = 0; i < TEXT_COUNT; ++i)
+        {
+            texts.push_back(DecimalFraction(millis(generator), 3).toString());
+        }
+        return texts;
+    }
+
+    const std::vector<std::string> texts = makeTexts();
+
+    bench::Registrar parseDouble("decimal/stod then Fraction(double)", 50, [](std::size_t iterations)
+                                 {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Fraction sum;
+            for (const std::string &text : texts)
+            {
+                sum += Fraction(std::stod(text));
+            }
+            bench::doNotOptimize(sum);
+        } });
+
+    bench::Registrar parseDecimal("decimal/DecimalFraction::parse and add", 50, [](std::size_t iterations)
+                                  {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            DecimalFraction sum;
+            for (const std::string &text : texts)
+            {
+                sum += *DecimalFraction::parse(text);
+            }
+            bench::doNotOptimize(sum);
+        } });
+
+    bench::Registrar printDecimal("decimal/DecimalFraction::toChars", 50, [](std::size_t iterations)
+                                  {
+        std::vector<DecimalFraction> values;
+        for (const std::string &text : texts)
+        {
+            values.push_back(*DecimalFraction::parse(text));
+        }
+        char buffer[32];
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (const DecimalFraction &value : values)
+            {
+                bench::doNotOptimize(value.toChars(buffer, buffer + sizeof(buffer)));
+            }
+        } });
+}
@@ -0,0 +1,96 @@
+#include "BenchHarness.hpp"
+#include "FixedFraction.hpp"
+#include "Fraction.hpp"
+#include <random>
+#include <vector>
+
+using ariel::Fraction;
+using Price = ariel::FixedFraction<1000>;
+
+namespace
+{
+    const std::size_t PRICE_COUNT = 4096;
+
+    std::vector<int> makeMillis()
+    {
+        std::mt19937 generator(13);
+        std::uniform_int_distribution<int> millis(-5000, 5000);
+        std::vector<int> values;
+        for (std::size_t i = 0; i < PRICE_COUNT; ++i)
+        {
+            values.push_back(millis(generator));
+        }
+        return values;
+    }
+
+    const std::vector<int> millis = makeMillis();
+
+    std::vector<Fraction> asFractions()
+    {
+        std::vector<Fraction> values;
+        for (int value : millis)
+        {
+            values.emplace_back(value, 1000);
+        }
+        return values;
+    }
+
+    std::vector<Price> asPrices()
+    {
+        std::vector<Price> values;
+        for (int value : millis)
+        {
+            values.push_back(Price::fromNumerator(value));
+        }
+        return values;
+    }
+
+    const std::vector<Fraction> fractions = asFractions();
+    const std::vector<Price> prices = asPrices();
+
+    bench::Registrar fractionSum("fixed/Fraction sum of prices", 200, [](std::size_t iterations)
+                                 {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Fraction sum;
+            for (const Fraction &value : fractions)
+            {
+                sum += value;
+            }
+            bench::doNotOptimize(sum);
+        } });
+
+    bench::Registrar fixedSum("fixed/FixedFraction<1000> sum of prices", 200, [](std::size_t iterations)
+                              {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Price sum;
+            for (const Price &value : prices)
+            {
+                sum += value;
+            }
+            bench::doNotOptimize(sum);
+        } });
+
+    bench::Registrar fractionScale("fixed/Fraction price * rate", 200, [](std::size_t iterations)
+                                   {
+        Fraction rate(21, 20);
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (const Fraction &value : fractions)
+            {
+                bench::doNotOptimize(value * rate);
+            }
+        } });
+
+    bench::Registrar fixedScale("fixed/FixedFraction<1000> price * rate", 200, [](std::size_t iterations)
+                                {
+        Price rate(Fraction(21, 20));
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (const Price &value : prices)
+            {
+                bench::doNotOptimize(value * rate);
+            }
+        } });
+}
@@ -0,0 +1,49 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionFormat.hpp"
+#include <random>
+#include <sstream>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t VALUE_COUNT = 4096;
+
+    std::vector<Fraction> makeValues()
+    {
+        std::mt19937 generator(41);
+        std::uniform_int_distribution<int> numerators(-1000000, 1000000);
+        std::uniform_int_distribution<int> denominators(1, 1000000);
+        std::vector<Fraction> values;
+        for (std::size_t i = 0; i < VALUE_COUNT; ++i)
+        {
+            values.emplace_back(numerators(generator), denominators(generator));
+        }
+        return values;
+    }
+
+    const std::vector<Fraction> values = makeValues();
+
+    bench::Registrar streamFormat("format/operator<< loop", 50, [](std::size_t iterations)
+                                  {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::ostringstream output;
+            for (const Fraction &value : values)
+            {
+                output << value << '\n';
+            }
+            bench::doNotOptimize(output.tellp());
+        } });
+
+    bench::Registrar writerFormat("format/FractionWriter", 50, [](std::size_t iterations)
+                                  {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::ostringstream output;
+            ariel::write_fractions(output, values);
+            bench::doNotOptimize(output.tellp());
+        } });
+}
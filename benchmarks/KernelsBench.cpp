@@ -0,0 +1,61 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionKernels.hpp"
+#include <random>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t VECTOR_LENGTH = 256;
+
+    /// values in [-1, 1] with power of two denominators so the naive loop never overflows
+    std::vector<Fraction> makeVector(unsigned seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> exponent(0, 6);
+        std::vector<Fraction> values;
+        for (std::size_t i = 0; i < VECTOR_LENGTH; ++i)
+        {
+            int denominator = 1 << exponent(generator);
+            std::uniform_int_distribution<int> numerator(-denominator, denominator);
+            values.emplace_back(numerator(generator), denominator);
+        }
+        return values;
+    }
+
+    const std::vector<Fraction> weights = makeVector(1);
+    const std::vector<Fraction> inputs = makeVector(2);
+
+    bench::Registrar naiveDot("dot/naive operator* and operator+=", 2000, [](std::size_t iterations)
+                              {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Fraction sum;
+            for (std::size_t i = 0; i < VECTOR_LENGTH; ++i)
+            {
+                sum += weights[i] * inputs[i];
+            }
+            bench::doNotOptimize(sum);
+        } });
+
+    bench::Registrar wideDot("dot/ariel::dot", 2000, [](std::size_t iterations)
+                             {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            bench::doNotOptimize(ariel::dot(weights, inputs));
+        } });
+
+    bench::Registrar fmaLoop("dot/ariel::fma loop", 2000, [](std::size_t iterations)
+                             {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            Fraction sum;
+            for (std::size_t i = 0; i < VECTOR_LENGTH; ++i)
+            {
+                sum = ariel::fma(weights[i], inputs[i], sum);
+            }
+            bench::doNotOptimize(sum);
+        } });
+}
@@ -0,0 +1,74 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionLoader.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t BYTES_PER_MEGABYTE = std::size_t(1) << 20;
+
+    /// size of the generated input, override with FRACTION_BENCH_LOAD_MB for multi-GB runs
+    std::size_t megabytes()
+    {
+        const char *configured = std::getenv("FRACTION_BENCH_LOAD_MB");
+        long value = configured == nullptr ? 0 : std::atol(configured);
+        return value > 0 ? (std::size_t)value : 32;
+    }
+
+    const std::size_t LOAD_MEGABYTES = megabytes();
+
+    /// generate "n d" records, the format understood by both operator>> and the loader, once per size
+    const std::string &inputPath()
+    {
+        static const std::string path = []()
+        {
+            std::filesystem::path file = std::filesystem::temp_directory_path() /
+                                         ("fraction_loader_bench_" + std::to_string(LOAD_MEGABYTES) + "mb.txt");
+            std::size_t target = LOAD_MEGABYTES * BYTES_PER_MEGABYTE;
+            if (!std::filesystem::exists(file) || std::filesystem::file_size(file) < target)
+            {
+                std::mt19937 generator(37);
+                std::uniform_int_distribution<int> numerators(-1000000, 1000000);
+                std::uniform_int_distribution<int> denominators(1, 1000000);
+                std::ofstream output(file);
+                std::string line;
+                for (std::size_t written = 0; written < target; written += line.size())
+                {
+                    line = std::to_string(numerators(generator)) + " " + std::to_string(denominators(generator)) + "\n";
+                    output << line;
+                }
+            }
+            return file.string();
+        }();
+        return path;
+    }
+
+    // iterations are megabytes of input, so the reported ns/iteration is ns per MB and MB/s = 1e9 / value
+    bench::Registrar streamLoad("loader/operator>> from ifstream, ns per MB", LOAD_MEGABYTES, [](std::size_t /*iterations*/)
+                                {
+        std::ifstream input(inputPath());
+        std::vector<Fraction> values;
+        Fraction value;
+        while (input >> std::ws && !input.eof())
+        {
+            input >> value;
+            values.push_back(value);
+        }
+        bench::doNotOptimize(values.size()); });
+
+    bench::Registrar serialLoad("loader/load_fractions 1 thread, ns per MB", LOAD_MEGABYTES, [](std::size_t /*iterations*/)
+                                {
+        ariel::FractionLoadResult result = ariel::load_fractions(inputPath(), 1);
+        bench::doNotOptimize(result.values.size()); });
+
+    bench::Registrar parallelLoad("loader/load_fractions all threads, ns per MB", LOAD_MEGABYTES, [](std::size_t /*iterations*/)
+                                  {
+        ariel::FractionLoadResult result = ariel::load_fractions(inputPath());
+        bench::doNotOptimize(result.values.size()); });
+}
@@ -0,0 +1,201 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t OPERAND_COUNT = 1024;
+    const std::size_t OPERAND_MASK = OPERAND_COUNT - 1;
+    const std::size_t OPERATION_COUNT = 1 << 16;
+
+    /// operands of one value distribution, right operands and floats are never 0 so that division is always defined
+    struct Operands
+    {
+        std::string name;
+        std::vector<Fraction> left;
+        std::vector<Fraction> right;
+        std::vector<int> numerators;
+        std::vector<int> denominators;
+        std::vector<float> floats;
+        std::string text;
+    };
+
+    /// components uniform in [-bound, bound] and [1, bound], denominators 1 if integral;
+    /// bounds up to 30000 keep every unreduced sum and product of two operands inside int
+    Operands makeOperands(const std::string &name, int bound, bool integral, unsigned seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<int> numerator(-bound, bound);
+        std::uniform_int_distribution<int> denominator(1, integral ? 1 : bound);
+        std::uniform_real_distribution<float> floating(0.5F, 10.0F);
+        std::bernoulli_distribution negative(0.5);
+        Operands operands;
+        operands.name = name;
+        std::ostringstream text;
+        for (std::size_t i = 0; i < OPERAND_COUNT; ++i)
+        {
+            int leftNumerator = numerator(generator);
+            int rightNumerator = 0;
+            while (rightNumerator == 0)
+            {
+                rightNumerator = numerator(generator);
+            }
+            operands.numerators.push_back(leftNumerator);
+            operands.denominators.push_back(denominator(generator));
+            operands.left.emplace_back(leftNumerator, operands.denominators.back());
+            operands.right.emplace_back(rightNumerator, denominator(generator));
+            operands.floats.push_back(negative(generator) ? -floating(generator) : floating(generator));
+            text << leftNumerator << " " << operands.denominators.back() << "\n";
+        }
+        operands.text = text.str();
+        return operands;
+    }
+
+    /// small stays inside the reduction tables, medium is spread over the range where
+    /// two-operand arithmetic cannot overflow, integers have denominator 1
+    const std::vector<Operands> distributions{
+        makeOperands("small", 255, false, 71),
+        makeOperands("medium", 30000, false, 73),
+        makeOperands("integers", 30000, true, 79),
+    };
+
+    /// register one benchmark per distribution, operation gets the operands and the index of the operation
+    template <typename Operation>
+    void registerOperator(const std::string &name, Operation operation)
+    {
+        for (const Operands &operands : distributions)
+        {
+            bench::Registrar("operator/" + name + " " + operands.name, OPERATION_COUNT, [&operands, operation](std::size_t iterations)
+                             {
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    operation(operands, iteration & OPERAND_MASK);
+                } });
+        }
+    }
+
+    /// register Fraction op Fraction, Fraction op float and float op Fraction for a binary operator
+    template <typename Operation>
+    void registerBinary(const std::string &symbol, Operation operation)
+    {
+        registerOperator("Fraction " + symbol + " Fraction", [operation](const Operands &operands, std::size_t index)
+                         { bench::doNotOptimize(operation(operands.left[index], operands.right[index])); });
+        registerOperator("Fraction " + symbol + " float", [operation](const Operands &operands, std::size_t index)
+                         { bench::doNotOptimize(operation(operands.left[index], operands.floats[index])); });
+        registerOperator("float " + symbol + " Fraction", [operation](const Operands &operands, std::size_t index)
+                         { bench::doNotOptimize(operation(operands.floats[index], operands.right[index])); });
+    }
+
+    /// register Fraction op= Fraction and Fraction op= float for a compound assignment
+    template <typename Operation>
+    void registerCompound(const std::string &symbol, Operation operation)
+    {
+        registerOperator("Fraction " + symbol + " Fraction", [operation](const Operands &operands, std::size_t index)
+                         {
+            Fraction value = operands.left[index];
+            bench::doNotOptimize(operation(value, operands.right[index])); });
+        registerOperator("Fraction " + symbol + " float", [operation](const Operands &operands, std::size_t index)
+                         {
+            Fraction value = operands.left[index];
+            bench::doNotOptimize(operation(value, operands.floats[index])); });
+    }
+
+    const bool registered = []()
+    {
+        registerOperator("Fraction(int, int)", [](const Operands &operands, std::size_t index)
+                         { bench::doNotOptimize(Fraction(operands.numerators[index], operands.denominators[index])); });
+        registerOperator("Fraction(float)", [](const Operands &operands, std::size_t index)
+                         { bench::doNotOptimize(Fraction(operands.floats[index])); });
+        registerOperator("Fraction(double)", [](const Operands &operands, std::size_t index)
+                         { bench::doNotOptimize(Fraction(static_cast<double>(operands.floats[index]))); });
+        registerOperator("copy", [](const Operands &operands, std::size_t index)
+                         {
+            Fraction copy(operands.left[index]);
+            bench::doNotOptimize(copy); });
+        registerOperator("move", [](const Operands &operands, std::size_t index)
+                         {
+            Fraction source(operands.left[index]);
+            Fraction moved(std::move(source));
+            bench::doNotOptimize(moved); });
+
+        registerBinary("+", [](const auto &left, const auto &right)
+                       { return left + right; });
+        registerBinary("-", [](const auto &left, const auto &right)
+                       { return left - right; });
+        registerBinary("*", [](const auto &left, const auto &right)
+                       { return left * right; });
+        registerBinary("/", [](const auto &left, const auto &right)
+                       { return left / right; });
+        registerCompound("+=", [](Fraction &value, const auto &right)
+                         { return value += right; });
+        registerCompound("-=", [](Fraction &value, const auto &right)
+                         { return value -= right; });
+        registerCompound("*=", [](Fraction &value, const auto &right)
+                         { return value *= right; });
+        registerCompound("/=", [](Fraction &value, const auto &right)
+                         { return value /= right; });
+
+        registerBinary("==", [](const auto &left, const auto &right)
+                       { return left == right; });
+        registerBinary("!=", [](const auto &left, const auto &right)
+                       { return left != right; });
+        registerBinary("<", [](const auto &left, const auto &right)
+                       { return left < right; });
+        registerBinary("<=", [](const auto &left, const auto &right)
+                       { return left <= right; });
+        registerBinary(">", [](const auto &left, const auto &right)
+                       { return left > right; });
+        registerBinary(">=", [](const auto &left, const auto &right)
+                       { return left >= right; });
+
+        registerOperator("++Fraction", [](const Operands &operands, std::size_t index)
+                         {
+            Fraction value = operands.left[index];
+            bench::doNotOptimize(++value); });
+        registerOperator("Fraction++", [](const Operands &operands, std::size_t index)
+                         {
+            Fraction value = operands.left[index];
+            bench::doNotOptimize(value++); });
+        registerOperator("--Fraction", [](const Operands &operands, std::size_t index)
+                         {
+            Fraction value = operands.left[index];
+            bench::doNotOptimize(--value); });
+        registerOperator("Fraction--", [](const Operands &operands, std::size_t index)
+                         {
+            Fraction value = operands.left[index];
+            bench::doNotOptimize(value--); });
+
+        // one stream per run, values are written to it and read from it one at a time
+        for (const Operands &operands : distributions)
+        {
+            bench::Registrar("operator/operator<< " + operands.name, OPERATION_COUNT, [&operands](std::size_t iterations)
+                             {
+                std::ostringstream output;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    output << operands.left[iteration & OPERAND_MASK] << "\n";
+                }
+                bench::doNotOptimize(output.tellp()); });
+            bench::Registrar("operator/operator>> " + operands.name, OPERATION_COUNT, [&operands](std::size_t iterations)
+                             {
+                std::istringstream input(operands.text);
+                Fraction value;
+                for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+                {
+                    if ((iteration & OPERAND_MASK) == 0)
+                    {
+                        input.clear();
+                        input.seekg(0);
+                    }
+                    input >> value;
+                    bench::doNotOptimize(value);
+                } });
+        }
+        return true;
+    }();
+}
@@ -0,0 +1,61 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionParse.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t RECORD_COUNT = 4096;
+
+    /// "n d" records, the format understood by both operator>> and parse_fraction
+    std::string makeText()
+    {
+        std::mt19937 generator(29);
+        std::uniform_int_distribution<int> numerators(-100000, 100000);
+        std::uniform_int_distribution<int> denominators(1, 100000);
+        std::string text;
+        for (std::size_t i = 0; i < RECORD_COUNT; ++i)
+        {
+            text += std::to_string(numerators(generator)) + " " + std::to_string(denominators(generator)) + "\n";
+        }
+        return text;
+    }
+
+    const std::string text = makeText();
+
+    bench::Registrar streamParse("parse/operator>> from istringstream", 50, [](std::size_t iterations)
+                                 {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::istringstream input(text);
+            long long checksum = 0;
+            Fraction value;
+            for (std::size_t record = 0; record < RECORD_COUNT; ++record)
+            {
+                input >> value;
+                checksum += value.getNumerator();
+            }
+            bench::doNotOptimize(checksum);
+        } });
+
+    bench::Registrar charsParse("parse/parse_fraction over the buffer", 50, [](std::size_t iterations)
+                                {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            const char *position = text.data();
+            const char *last = text.data() + text.size();
+            long long checksum = 0;
+            Fraction value;
+            while (position != last)
+            {
+                position += ariel::parse_fraction(position, last, value).consumed;
+                checksum += value.getNumerator();
+                ++position;
+            }
+            bench::doNotOptimize(checksum);
+        } });
+}
@@ -0,0 +1,164 @@
+#include "PerfCounters.hpp"
+#include <cerrno>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench
+{
+#ifdef __linux__
+    namespace
+    {
+        /// layout of read() with PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+        struct CounterReading
+        {
+            std::uint64_t value;
+            std::uint64_t timeEnabled;
+            std::uint64_t timeRunning;
+        };
+
+        bool readEvent(int descriptor, CounterReading &reading)
+        {
+            return read(descriptor, &reading, sizeof(reading)) == static_cast<ssize_t>(sizeof(reading));
+        }
+
+        int openEvent(std::uint64_t config)
+        {
+            perf_event_attr attributes{};
+            attributes.size = sizeof(attributes);
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = config;
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            // threads started later count too, their totals are added to this event when they exit
+            attributes.inherit = 1;
+            attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+    }
+
+    PerfCounters::PerfCounters()
+    {
+        const std::array<std::uint64_t, eventCount> configs{PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+                                                            PERF_COUNT_HW_CACHE_MISSES};
+        for (std::size_t event = 0; event < eventCount; ++event)
+        {
+            descriptors[event] = openEvent(configs[event]);
+            if (descriptors[event] < 0 && reason.empty())
+            {
+                reason = std::string(name(static_cast<Event>(event))) + ": " + std::strerror(errno);
+            }
+        }
+    }
+
+    PerfCounters::~PerfCounters()
+    {
+        for (int descriptor : descriptors)
+        {
+            if (descriptor >= 0)
+            {
+                close(descriptor);
+            }
+        }
+    }
+
+    void PerfCounters::start()
+    {
+        // PERF_EVENT_IOC_RESET does not clear the totals of exited threads, so counts are taken as differences
+        for (std::size_t event = 0; event < eventCount; ++event)
+        {
+            CounterReading reading{};
+            if (descriptors[event] >= 0 && readEvent(descriptors[event], reading))
+            {
+                baselines[event] = {reading.value, reading.timeEnabled, reading.timeRunning};
+            }
+        }
+        for (int descriptor : descriptors)
+        {
+            if (descriptor >= 0)
+            {
+                ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    PerfCounters::Sample PerfCounters::stop()
+    {
+        for (int descriptor : descriptors)
+        {
+            if (descriptor >= 0)
+            {
+                ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+        Sample sample;
+        for (std::size_t event = 0; event < eventCount; ++event)
+        {
+            CounterReading reading{};
+            if (descriptors[event] < 0 || !readEvent(descriptors[event], reading))
+            {
+                continue;
+            }
+            const std::array<std::uint64_t, 3> &baseline = baselines[event];
+            std::uint64_t running = reading.timeRunning - baseline[2];
+            if (running == 0)
+            {
+                continue;
+            }
+            // the kernel counted only while the event was scheduled, extrapolate to the whole interval
+            sample.values[event] = static_cast<double>(reading.value - baseline[0]) * static_cast<double>(reading.timeEnabled - baseline[1]) /
+                                   static_cast<double>(running);
+        }
+        return sample;
+    }
+#else
+    PerfCounters::PerfCounters() : reason("hardware counters need Linux perf_event_open")
+    {
+        descriptors.fill(-1);
+    }
+
+    PerfCounters::~PerfCounters() = default;
+
+    void PerfCounters::start()
+    {
+    }
+
+    PerfCounters::Sample PerfCounters::stop()
+    {
+        return Sample{};
+    }
+#endif
+
+    bool PerfCounters::available(Event event) const
+    {
+        return descriptors[event] >= 0;
+    }
+
+    bool PerfCounters::anyAvailable() const
+    {
+        for (int descriptor : descriptors)
+        {
+            if (descriptor >= 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::string &PerfCounters::unavailableReason() const
+    {
+        return reason;
+    }
+
+    const char *PerfCounters::name(Event event)
+    {
+        const std::array<const char *, eventCount> names{"cycles", "instructions", "branch-misses", "cache-misses"};
+        return names[event];
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace bench
+{
+    /// @brief
+    /// Hardware counters read through Linux perf_event_open: cycles, instructions, branch misses and cache
+    /// misses of the calling thread and of the threads it starts after construction, so threaded benchmarks
+    /// are counted whole. A started thread is counted once it has exited, i.e. joined before stop. Counters the kernel or the machine does not provide (no PMU in a
+    /// virtual machine, perf_event_paranoid too high, not Linux) are reported as unavailable instead of
+    /// failing, and the others keep working. Counts are scaled when the kernel multiplexes counters.
+    class PerfCounters
+    {
+    public:
+        /// @brief the counted events, in the order of Sample::values
+        enum Event
+        {
+            cycles,
+            instructions,
+            branchMisses,
+            cacheMisses,
+            eventCount
+        };
+
+        /// @brief counts between start and stop, values of unavailable events are 0
+        struct Sample
+        {
+            std::array<double, eventCount> values{};
+        };
+
+        /// @brief open every event, disabled
+        PerfCounters();
+
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters &operator=(const PerfCounters &) = delete;
+
+        /// @brief close the events
+        ~PerfCounters();
+
+        /// @brief true if the event could be opened
+        bool available(Event event) const;
+
+        /// @brief true if at least one event could be opened
+        bool anyAvailable() const;
+
+        /// @brief why an event is missing, empty if every event is available
+        const std::string &unavailableReason() const;
+
+        /// @brief name of an event as used in the reports, e.g. "branch-misses"
+        static const char *name(Event event);
+
+        /// @brief reset and enable every available event
+        void start();
+
+        /// @brief disable every available event
+        /// @return the counts since start
+        Sample stop();
+
+    private:
+        std::array<int, eventCount> descriptors{};
+        /// value, time enabled and time running of each event at start, stop reports the differences
+        std::array<std::array<std::uint64_t, 3>, eventCount> baselines{};
+        std::string reason;
+    };
+}
@@ -0,0 +1,72 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionPipeline.hpp"
+#include "FractionStream.hpp"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t RECORD_COUNT = 1 << 16;
+
+    std::string makeText()
+    {
+        std::mt19937 generator(61);
+        std::uniform_int_distribution<int> numerators(-100000, 100000);
+        std::uniform_int_distribution<int> denominators(1, 1000);
+        std::string text;
+        for (std::size_t i = 0; i < RECORD_COUNT; ++i)
+        {
+            text += std::to_string(numerators(generator)) + " " + std::to_string(denominators(generator)) + "\n";
+        }
+        return text;
+    }
+
+    const std::string text = makeText();
+
+    std::size_t twice(std::span<Fraction> batch)
+    {
+        for (Fraction &value : batch)
+        {
+            value *= Fraction(2);
+        }
+        return batch.size();
+    }
+
+    void runPipeline(std::size_t iterations, unsigned threads)
+    {
+        ariel::FractionPipelineConfig config;
+        config.chunkBytes = 1 << 15;
+        config.parseThreads = threads;
+        config.computeThreads = threads;
+        config.formatThreads = threads;
+        ariel::FractionPipeline pipeline(config);
+        pipeline.addKernel(twice);
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::istringstream input(text);
+            std::ostringstream output;
+            bench::doNotOptimize(pipeline.run(input, output).valuesWritten);
+        }
+    }
+
+    bench::Registrar sequentialStream("pipeline/process_fraction_stream", 5, [](std::size_t iterations)
+                                      {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::istringstream input(text);
+            std::ostringstream output;
+            bench::doNotOptimize(ariel::process_fraction_stream(input, output, {twice}).valuesWritten);
+        } });
+
+    bench::Registrar singleWorkers("pipeline/staged 1 thread per stage", 5, [](std::size_t iterations)
+                                   { runPipeline(iterations, 1); });
+
+    bench::Registrar hardwareWorkers("pipeline/staged hardware threads per stage", 5, [](std::size_t iterations)
+                                     { runPipeline(iterations, std::max(1U, std::thread::hardware_concurrency() / 2)); });
+}
@@ -0,0 +1,143 @@
+#include "BenchHarness.hpp"
+#include "ConcurrentQueue.hpp"
+#include "Fraction.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t VALUE_COUNT = 1 << 18;
+    const std::size_t QUEUE_CAPACITY = 1024;
+    const std::size_t BATCH_SIZE = 64;
+
+    /// bounded std::queue behind a mutex, the transport the lock-free queues replace
+    class MutexQueue
+    {
+    private:
+        std::mutex mutex;
+        std::queue<Fraction> values;
+
+    public:
+        explicit MutexQueue(std::size_t /*capacity*/) {}
+
+        std::size_t tryPushBatch(std::span<Fraction> batch)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::size_t count = std::min(batch.size(), QUEUE_CAPACITY - values.size());
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                values.push(batch[index]);
+            }
+            return count;
+        }
+
+        std::size_t tryPopBatch(std::span<Fraction> batch)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::size_t count = std::min(batch.size(), values.size());
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                batch[index] = values.front();
+                values.pop();
+            }
+            return count;
+        }
+    };
+
+    /// move count values through the queue with threads split evenly between producers and consumers,
+    /// a single thread alternates between pushing and popping a batch
+    template <typename Queue>
+    void transfer(Queue &queue, std::size_t count, unsigned threads, std::size_t batchSize)
+    {
+        std::vector<Fraction> source(batchSize, Fraction(1, 3));
+        if (threads == 1)
+        {
+            std::vector<Fraction> values(batchSize);
+            std::vector<Fraction> batch(batchSize);
+            for (std::size_t moved = 0; moved < count; moved += batchSize)
+            {
+                std::copy(source.begin(), source.end(), values.begin());
+                queue.tryPushBatch(values);
+                bench::doNotOptimize(queue.tryPopBatch(batch));
+            }
+            return;
+        }
+        unsigned producers = threads / 2;
+        std::size_t perProducer = count / producers;
+        std::atomic<std::size_t> received{0};
+        std::vector<std::thread> pool;
+        for (unsigned producer = 0; producer < producers; ++producer)
+        {
+            pool.emplace_back([&queue, &source, perProducer, batchSize]()
+                              {
+                std::vector<Fraction> batch(batchSize);
+                for (std::size_t sent = 0; sent < perProducer; sent += batchSize)
+                {
+                    std::copy(source.begin(), source.end(), batch.begin());
+                    std::span<Fraction> rest(batch.data(), std::min(batchSize, perProducer - sent));
+                    while (!rest.empty())
+                    {
+                        std::size_t pushed = queue.tryPushBatch(rest);
+                        rest = rest.subspan(pushed);
+                        if (pushed == 0)
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                } });
+        }
+        std::size_t total = perProducer * producers;
+        for (unsigned consumer = producers; consumer < threads; ++consumer)
+        {
+            pool.emplace_back([&queue, &received, total, batchSize]()
+                              {
+                std::vector<Fraction> batch(batchSize);
+                while (received.load(std::memory_order_relaxed) < total)
+                {
+                    std::size_t popped = queue.tryPopBatch(batch);
+                    if (popped == 0)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    received.fetch_add(popped, std::memory_order_relaxed);
+                    bench::doNotOptimize(batch[0]);
+                } });
+        }
+        for (std::thread &thread : pool)
+        {
+            thread.join();
+        }
+    }
+
+    template <typename Queue>
+    void registerContention(const std::string &label, const std::vector<unsigned> &threadCounts, std::size_t batchSize)
+    {
+        for (unsigned threads : threadCounts)
+        {
+            bench::Registrar(label + " " + std::to_string(threads) + " threads", VALUE_COUNT, [threads, batchSize](std::size_t iterations)
+                             {
+                Queue queue(QUEUE_CAPACITY);
+                transfer(queue, iterations, threads, batchSize); });
+        }
+    }
+
+    const std::vector<unsigned> THREAD_COUNTS{1, 2, 8, 64};
+
+    const bool registered = []()
+    {
+        registerContention<MutexQueue>("queue/mutex std::queue batch 64", THREAD_COUNTS, BATCH_SIZE);
+        registerContention<ariel::ConcurrentQueue<Fraction>>("queue/mpmc single value", THREAD_COUNTS, 1);
+        registerContention<ariel::ConcurrentQueue<Fraction>>("queue/mpmc batch 64", THREAD_COUNTS, BATCH_SIZE);
+        registerContention<ariel::SpscQueue<Fraction>>("queue/spsc batch 64", {1, 2}, BATCH_SIZE);
+        return true;
+    }();
+}
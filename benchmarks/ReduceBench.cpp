@@ -0,0 +1,77 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionTables.hpp"
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t PAIR_COUNT = 4096;
+    const int SMALL_PERCENT = 90;
+
+    /// 90% of the pairs have both components below 256, the rest are up to 10^6
+    std::vector<std::pair<int, int>> makePairs()
+    {
+        std::mt19937 generator(5);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<int> small(1, 255);
+        std::uniform_int_distribution<int> large(1, 1000000);
+        std::vector<std::pair<int, int>> pairs;
+        for (std::size_t i = 0; i < PAIR_COUNT; ++i)
+        {
+            bool isSmall = percent(generator) < SMALL_PERCENT;
+            pairs.emplace_back(isSmall ? small(generator) : large(generator), isSmall ? small(generator) : large(generator));
+        }
+        return pairs;
+    }
+
+    const std::vector<std::pair<int, int>> pairs = makePairs();
+
+    bench::Registrar gcdReduce("reduce/std::gcd", 500, [](std::size_t iterations)
+                               {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (const auto &[numeratorVal, denominatorVal] : pairs)
+            {
+                int numerator = numeratorVal, denominator = denominatorVal;
+                int gcd = std::gcd(numerator, denominator);
+                numerator /= gcd;
+                denominator /= gcd;
+                bench::doNotOptimize(numerator);
+                bench::doNotOptimize(denominator);
+            }
+        } });
+
+    bench::Registrar tableReduce("reduce/small tables with std::gcd fallback", 500, [](std::size_t iterations)
+                                 {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (const auto &[numeratorVal, denominatorVal] : pairs)
+            {
+                int numerator = numeratorVal, denominator = denominatorVal;
+                if (!ariel::DefaultSmallTables::reduce(numerator, denominator))
+                {
+                    int gcd = std::gcd(numerator, denominator);
+                    numerator /= gcd;
+                    denominator /= gcd;
+                }
+                bench::doNotOptimize(numerator);
+                bench::doNotOptimize(denominator);
+            }
+        } });
+
+    bench::Registrar construct("reduce/Fraction(n, d)", 500, [](std::size_t iterations)
+                               {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            for (const auto &[numerator, denominator] : pairs)
+            {
+                Fraction fraction(numerator, denominator);
+                bench::doNotOptimize(fraction);
+            }
+        } });
+}
@@ -0,0 +1,73 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionSort.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t SORT_SIZE = 200000;
+
+    std::vector<Fraction> makeInput()
+    {
+        std::mt19937 generator(11);
+        std::uniform_int_distribution<int> numerator(-1000000, 1000000);
+        std::uniform_int_distribution<int> denominator(1, 1000);
+        std::vector<Fraction> values;
+        for (std::size_t i = 0; i < SORT_SIZE; ++i)
+        {
+            values.emplace_back(numerator(generator), denominator(generator));
+        }
+        return values;
+    }
+
+    const std::vector<Fraction> input = makeInput();
+
+    bench::Registrar stdSort("sort/std::sort operator<", 1, [](std::size_t iterations)
+                             {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::vector<Fraction> values = input;
+            std::sort(values.begin(), values.end());
+            bench::doNotOptimize(values.front());
+        } });
+
+    bench::Registrar stdSortExact("sort/std::sort ExactLess", 1, [](std::size_t iterations)
+                                  {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::vector<Fraction> values = input;
+            std::sort(values.begin(), values.end(), ariel::ExactLess());
+            bench::doNotOptimize(values.front());
+        } });
+
+    bench::Registrar keyedSort("sort/sort_fractions", 1, [](std::size_t iterations)
+                               {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::vector<Fraction> values = input;
+            ariel::sort_fractions(values);
+            bench::doNotOptimize(values.front());
+        } });
+
+    bench::Registrar radixSort("sort/radix_sort_fractions", 1, [](std::size_t iterations)
+                               {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::vector<Fraction> values = input;
+            ariel::radix_sort_fractions(values, ariel::RadixKeyRange{Fraction(-1000000), Fraction(1000000), 1000});
+            bench::doNotOptimize(values.front());
+        } });
+
+    bench::Registrar mergeSort("sort/parallel_merge_sort_fractions", 1, [](std::size_t iterations)
+                               {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::vector<Fraction> values = input;
+            ariel::parallel_merge_sort_fractions(values);
+            bench::doNotOptimize(values.front());
+        } });
+}
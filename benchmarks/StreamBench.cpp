@@ -0,0 +1,62 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionStream.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t RECORD_COUNT = 1 << 16;
+
+    std::string makeText()
+    {
+        std::mt19937 generator(59);
+        std::uniform_int_distribution<int> numerators(-100000, 100000);
+        std::uniform_int_distribution<int> denominators(1, 1000);
+        std::string text;
+        for (std::size_t i = 0; i < RECORD_COUNT; ++i)
+        {
+            text += std::to_string(numerators(generator)) + " " + std::to_string(denominators(generator)) + "\n";
+        }
+        return text;
+    }
+
+    const std::string text = makeText();
+
+    bench::Registrar streamLoop("stream/operator>> transform operator<< loop", 5, [](std::size_t iterations)
+                                {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::istringstream input(text);
+            std::ostringstream output;
+            Fraction value;
+            for (std::size_t record = 0; record < RECORD_COUNT; ++record)
+            {
+                input >> value;
+                output << value * Fraction(2) << "\n";
+            }
+            bench::doNotOptimize(output.tellp());
+        } });
+
+    bench::Registrar streamPipeline("stream/process_fraction_stream", 5, [](std::size_t iterations)
+                                    {
+        ariel::FractionBatchTransform twice = [](std::span<Fraction> batch)
+        {
+            for (Fraction &value : batch)
+            {
+                value *= Fraction(2);
+            }
+            return batch.size();
+        };
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::istringstream input(text);
+            std::ostringstream output;
+            ariel::process_fraction_stream(input, output, {twice});
+            bench::doNotOptimize(output.tellp());
+        } });
+}
@@ -0,0 +1,77 @@
+#include "BenchHarness.hpp"
+#include "Fraction.hpp"
+#include "FractionTable.hpp"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using ariel::Fraction;
+
+namespace
+{
+    const std::size_t TABLE_SIZE = 1 << 18;
+
+    std::vector<Fraction> makeValues()
+    {
+        std::mt19937 generator(47);
+        std::uniform_int_distribution<int> numerators(-1000000, 1000000);
+        std::uniform_int_distribution<int> denominators(1, 1000000);
+        std::vector<Fraction> values;
+        for (std::size_t i = 0; i < TABLE_SIZE; ++i)
+        {
+            values.emplace_back(numerators(generator), denominators(generator));
+        }
+        return values;
+    }
+
+    /// the same reference table as text and as a mapped table file
+    struct Files
+    {
+        std::string text;
+        std::string table;
+
+        Files()
+        {
+            std::filesystem::path directory = std::filesystem::temp_directory_path();
+            text = (directory / "fraction_table_bench.txt").string();
+            table = (directory / "fraction_table_bench.bin").string();
+            std::vector<Fraction> values = makeValues();
+            std::ofstream output(text);
+            for (const Fraction &value : values)
+            {
+                output << value.getNumerator() << " " << value.getDenominator() << "\n";
+            }
+            ariel::write_fraction_table(table, values);
+        }
+    };
+
+    const Files &files()
+    {
+        static const Files instance;
+        return instance;
+    }
+
+    // one iteration is a worker startup that loads the table and reads one element
+    bench::Registrar textStartup("table/startup parsing text with operator>>", 1, [](std::size_t iterations)
+                                 {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            std::ifstream input(files().text);
+            std::vector<Fraction> values(TABLE_SIZE);
+            for (Fraction &value : values)
+            {
+                input >> value;
+            }
+            bench::doNotOptimize(values[TABLE_SIZE / 2]);
+        } });
+
+    bench::Registrar mappedStartup("table/startup mapping FractionTable", 1, [](std::size_t iterations)
+                                   {
+        for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+        {
+            ariel::FractionTable table(files().table);
+            bench::doNotOptimize(table[TABLE_SIZE / 2]);
+        } });
+}
@@ -0,0 +1,199 @@
+#pragma once
+#include "Fraction.hpp"
+#include "FractionTables.hpp"
+#include "FractionWide.hpp"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace ariel
+{
+    /// @brief
+    /// Fraction that several threads can update without a lock. The reduced numerator and denominator
+    /// are packed in one 64-bit atomic word, so load and store are single instructions and the
+    /// read-modify-write operations are CAS loops. Since values are always reduced with a positive
+    /// denominator, equal values have equal words and compare_exchange compares exactly, unlike
+    /// Fraction::operator== which rounds to 3 digits.
+    class AtomicFraction
+    {
+    private:
+        std::atomic<std::uint64_t> word;
+
+        static std::uint64_t pack(int numerator, int denominator)
+        {
+            return (std::uint64_t(static_cast<std::uint32_t>(numerator)) << 32) | static_cast<std::uint32_t>(denominator);
+        }
+
+        static std::uint64_t pack(const Fraction &value)
+        {
+            return pack(value.getNumerator(), value.getDenominator());
+        }
+
+        static Fraction unpack(std::uint64_t packed)
+        {
+            return WideRational::trusted(static_cast<int>(static_cast<std::uint32_t>(packed >> 32)), static_cast<int>(static_cast<std::uint32_t>(packed)));
+        }
+
+        /// @brief packed, reduced sum of a packed value and numerator/denominator
+        /// @return false if the reduced sum does not fit in int, result is then unchanged
+        static bool add(std::uint64_t current, long long numerator, long long denominator, std::uint64_t &result)
+        {
+            auto currentNumerator = static_cast<long long>(static_cast<int>(static_cast<std::uint32_t>(current >> 32)));
+            auto currentDenominator = static_cast<long long>(static_cast<std::uint32_t>(current));
+            long long sumNumerator = 0;
+            long long sumDenominator = currentDenominator;
+            // components are at most 2^31 in magnitude, so both products and their sum fit in 63 bits
+            if (currentDenominator == denominator)
+            {
+                sumNumerator = currentNumerator + numerator;
+            }
+            else
+            {
+                sumNumerator = currentNumerator * denominator + numerator * currentDenominator;
+                sumDenominator = currentDenominator * denominator;
+            }
+            if (sumNumerator >= std::numeric_limits<int>::min() && sumNumerator <= std::numeric_limits<int>::max() &&
+                sumDenominator <= std::numeric_limits<int>::max())
+            {
+                auto narrowNumerator = static_cast<int>(sumNumerator);
+                auto narrowDenominator = static_cast<int>(sumDenominator);
+#ifndef FRACTION_NO_SMALL_TABLES
+                if (!DefaultSmallTables::reduce(narrowNumerator, narrowDenominator))
+#endif
+                {
+                    int divisor = std::gcd(narrowNumerator, narrowDenominator);
+                    narrowNumerator /= divisor;
+                    narrowDenominator /= divisor;
+                }
+                result = pack(narrowNumerator, narrowDenominator);
+                return true;
+            }
+            long long divisor = std::gcd(sumNumerator, sumDenominator);
+            sumNumerator /= divisor;
+            sumDenominator /= divisor;
+            if (sumNumerator > std::numeric_limits<int>::max() || sumNumerator < std::numeric_limits<int>::min() ||
+                sumDenominator > std::numeric_limits<int>::max())
+            {
+                return false;
+            }
+            result = pack(static_cast<int>(sumNumerator), static_cast<int>(sumDenominator));
+            return true;
+        }
+
+        bool tryFetchAddComponents(long long numerator, long long denominator, Fraction &previous, std::memory_order order)
+        {
+            std::uint64_t current = word.load(std::memory_order_relaxed);
+            std::uint64_t desired = 0;
+            do
+            {
+                if (!add(current, numerator, denominator, desired))
+                {
+                    previous = unpack(current);
+                    return false;
+                }
+            } while (!word.compare_exchange_weak(current, desired, order, std::memory_order_relaxed));
+            previous = unpack(current);
+            return true;
+        }
+
+    public:
+        /// @brief true on every platform this library supports, the atomic word never falls back to a lock
+        static constexpr bool is_always_lock_free = std::atomic<std::uint64_t>::is_always_lock_free;
+
+        /// @brief default constructor, value 0/1
+        AtomicFraction() : word(pack(0, 1)) {}
+
+        /// @brief constructor from an initial value
+        explicit AtomicFraction(const Fraction &value) : word(pack(value)) {}
+
+        AtomicFraction(const AtomicFraction &) = delete;
+        AtomicFraction &operator=(const AtomicFraction &) = delete;
+
+        /// @brief current value
+        Fraction load(std::memory_order order = std::memory_order_seq_cst) const
+        {
+            return unpack(word.load(order));
+        }
+
+        /// @brief replace the value
+        void store(const Fraction &value, std::memory_order order = std::memory_order_seq_cst)
+        {
+            word.store(pack(value), order);
+        }
+
+        /// @brief replace the value
+        /// @return the value it replaced
+        Fraction exchange(const Fraction &value, std::memory_order order = std::memory_order_seq_cst)
+        {
+            return unpack(word.exchange(pack(value), order));
+        }
+
+        /// @brief store desired if the value is exactly expected, may fail spuriously
+        /// @param expected receives the current value on failure
+        /// @return true if desired was stored
+        bool compare_exchange_weak(Fraction &expected, const Fraction &desired, std::memory_order order = std::memory_order_seq_cst)
+        {
+            std::uint64_t current = pack(expected);
+            if (word.compare_exchange_weak(current, pack(desired), order))
+            {
+                return true;
+            }
+            expected = unpack(current);
+            return false;
+        }
+
+        /// @brief store desired if the value is exactly expected
+        /// @param expected receives the current value on failure
+        /// @return true if desired was stored
+        bool compare_exchange_strong(Fraction &expected, const Fraction &desired, std::memory_order order = std::memory_order_seq_cst)
+        {
+            std::uint64_t current = pack(expected);
+            if (word.compare_exchange_strong(current, pack(desired), order))
+            {
+                return true;
+            }
+            expected = unpack(current);
+            return false;
+        }
+
+        /// @brief add delta atomically unless the reduced sum overflows
+        /// @param previous receives the value before the addition, or the value that could not be added to
+        /// @return false if the sum does not fit, the value is then left unchanged
+        bool try_fetch_add(const Fraction &delta, Fraction &previous, std::memory_order order = std::memory_order_seq_cst)
+        {
+            return tryFetchAddComponents(delta.getNumerator(), delta.getDenominator(), previous, order);
+        }
+
+        /// @brief subtract delta atomically unless the reduced difference overflows, see try_fetch_add
+        bool try_fetch_sub(const Fraction &delta, Fraction &previous, std::memory_order order = std::memory_order_seq_cst)
+        {
+            return tryFetchAddComponents(-static_cast<long long>(delta.getNumerator()), delta.getDenominator(), previous, order);
+        }
+
+        /// @brief add delta atomically
+        /// @return the value before the addition, throws overflow_error if the sum does not fit, in which
+        /// case the value is left unchanged
+        Fraction fetch_add(const Fraction &delta, std::memory_order order = std::memory_order_seq_cst)
+        {
+            Fraction previous;
+            if (!try_fetch_add(delta, previous, order))
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            return previous;
+        }
+
+        /// @brief subtract delta atomically, see fetch_add
+        Fraction fetch_sub(const Fraction &delta, std::memory_order order = std::memory_order_seq_cst)
+        {
+            Fraction previous;
+            if (!try_fetch_sub(delta, previous, order))
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            return previous;
+        }
+    };
+}
@@ -0,0 +1,249 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace ariel
+{
+    /// @brief alignment that keeps indices written by different threads on different cache lines
+    const std::size_t CACHE_LINE_SIZE = 64;
+
+    /// @brief smallest power of two holding capacity values, at least 2
+    inline std::size_t queueCapacity(std::size_t capacity)
+    {
+        return std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity);
+    }
+
+    /// @brief
+    /// Bounded lock-free multi producer multi consumer queue (Vyukov). Every cell carries a sequence
+    /// number that tells producers and consumers whose turn it is, so push and pop are a single CAS on
+    /// the shared position plus a release store on the cell. Full and empty are reported, not waited on.
+    /// The batch operations claim a run of cells with one CAS, which is what makes passing e.g.
+    /// ConcurrentQueue<Fraction> values between batch kernels cheap under contention.
+    /// @tparam T movable value type
+    template <typename T>
+    class ConcurrentQueue
+    {
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        std::size_t mask;
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueuePosition{0};
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeuePosition{0};
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)]{};
+
+        /// @brief number of consecutive cells from position, at most limit, whose sequence is position + index + lag
+        std::size_t readyCells(std::size_t position, std::size_t limit, std::size_t lag) const
+        {
+            std::size_t count = 0;
+            while (count < limit && count <= mask &&
+                   cells[(position + count) & mask].sequence.load(std::memory_order_acquire) == position + count + lag)
+            {
+                ++count;
+            }
+            return count;
+        }
+
+        /// @brief claim up to limit consecutive cells of the shared position whose sequence is position + lag
+        /// @return first claimed position and number of claimed cells, 0 if none is ready
+        std::pair<std::size_t, std::size_t> claim(std::atomic<std::size_t> &shared, std::size_t limit, std::size_t lag)
+        {
+            std::size_t position = shared.load(std::memory_order_relaxed);
+            if (limit == 0)
+            {
+                // nothing to claim, and with no ready cell to count the loop below would never exit
+                return {position, 0};
+            }
+            for (;;)
+            {
+                std::size_t count = readyCells(position, limit, lag);
+                if (count == 0)
+                {
+                    std::size_t sequence = cells[position & mask].sequence.load(std::memory_order_acquire);
+                    auto difference = static_cast<std::ptrdiff_t>(sequence - (position + lag));
+                    if (difference < 0)
+                    {
+                        return {position, 0};
+                    }
+                    if (difference > 0)
+                    {
+                        position = shared.load(std::memory_order_relaxed);
+                    }
+                }
+                else if (shared.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+                {
+                    return {position, count};
+                }
+            }
+        }
+
+    public:
+        /// @brief constructor for a queue holding at least capacity values
+        /// @param capacity rounded up to a power of two, at least 2
+        explicit ConcurrentQueue(std::size_t capacity)
+            : cells(std::make_unique<Cell[]>(queueCapacity(capacity))), mask(queueCapacity(capacity) - 1)
+        {
+            for (std::size_t index = 0; index <= mask; ++index)
+            {
+                cells[index].sequence.store(index, std::memory_order_relaxed);
+            }
+        }
+
+        ConcurrentQueue(const ConcurrentQueue &) = delete;
+        ConcurrentQueue &operator=(const ConcurrentQueue &) = delete;
+
+        /// @brief number of values the queue can hold
+        std::size_t capacity() const
+        {
+            return mask + 1;
+        }
+
+        /// @brief move a value into the queue
+        /// @return false if the queue is full, value is then left untouched
+        bool tryPush(T &value)
+        {
+            return tryPushBatch(std::span<T>(&value, 1)) == 1;
+        }
+
+        /// @brief move the oldest value out of the queue
+        /// @return false if the queue is empty
+        bool tryPop(T &value)
+        {
+            return tryPopBatch(std::span<T>(&value, 1)) == 1;
+        }
+
+        /// @brief move a prefix of values into the queue as one run
+        /// @return number of values moved, 0 if the queue is full
+        std::size_t tryPushBatch(std::span<T> values)
+        {
+            auto [position, count] = claim(enqueuePosition, values.size(), 0);
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                Cell &cell = cells[(position + index) & mask];
+                cell.value = std::move(values[index]);
+                cell.sequence.store(position + index + 1, std::memory_order_release);
+            }
+            return count;
+        }
+
+        /// @brief move up to values.size() of the oldest values out of the queue, in order
+        /// @return number of values moved, 0 if the queue is empty
+        std::size_t tryPopBatch(std::span<T> values)
+        {
+            auto [position, count] = claim(dequeuePosition, values.size(), 1);
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                Cell &cell = cells[(position + index) & mask];
+                values[index] = std::move(cell.value);
+                cell.sequence.store(position + index + mask + 1, std::memory_order_release);
+            }
+            return count;
+        }
+    };
+
+    /// @brief
+    /// Bounded lock-free single producer single consumer ring. Each side owns one index and keeps a
+    /// cached copy of the other one on its own cache line, so a batch costs one acquire load at most
+    /// and one release store, with no read-modify-write at all. Exactly one thread may push and
+    /// exactly one thread may pop.
+    /// @tparam T movable value type
+    template <typename T>
+    class SpscQueue
+    {
+    private:
+        std::unique_ptr<T[]> values;
+        std::size_t mask;
+        /// written by the producer, cachedHead is only used by the producer
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail{0};
+        std::size_t cachedHead = 0;
+        /// written by the consumer, cachedTail is only used by the consumer
+        alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head{0};
+        std::size_t cachedTail = 0;
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)]{};
+
+    public:
+        /// @brief constructor for a ring holding at least capacity values
+        /// @param capacity rounded up to a power of two, at least 2
+        explicit SpscQueue(std::size_t capacity)
+            : values(std::make_unique<T[]>(queueCapacity(capacity))), mask(queueCapacity(capacity) - 1)
+        {
+        }
+
+        SpscQueue(const SpscQueue &) = delete;
+        SpscQueue &operator=(const SpscQueue &) = delete;
+
+        /// @brief number of values the ring can hold
+        std::size_t capacity() const
+        {
+            return mask + 1;
+        }
+
+        /// @brief move a value into the ring, producer thread only
+        /// @return false if the ring is full, value is then left untouched
+        bool tryPush(T &value)
+        {
+            return tryPushBatch(std::span<T>(&value, 1)) == 1;
+        }
+
+        /// @brief move the oldest value out of the ring, consumer thread only
+        /// @return false if the ring is empty
+        bool tryPop(T &value)
+        {
+            return tryPopBatch(std::span<T>(&value, 1)) == 1;
+        }
+
+        /// @brief move a prefix of batch into the ring, producer thread only
+        /// @return number of values moved, 0 if the ring is full
+        std::size_t tryPushBatch(std::span<T> batch)
+        {
+            std::size_t position = tail.load(std::memory_order_relaxed);
+            std::size_t room = capacity() - (position - cachedHead);
+            if (room < batch.size())
+            {
+                cachedHead = head.load(std::memory_order_acquire);
+                room = capacity() - (position - cachedHead);
+            }
+            std::size_t count = room < batch.size() ? room : batch.size();
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                values[(position + index) & mask] = std::move(batch[index]);
+            }
+            if (count != 0)
+            {
+                tail.store(position + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        /// @brief move up to batch.size() of the oldest values out of the ring, consumer thread only
+        /// @return number of values moved, 0 if the ring is empty
+        std::size_t tryPopBatch(std::span<T> batch)
+        {
+            std::size_t position = head.load(std::memory_order_relaxed);
+            std::size_t available = cachedTail - position;
+            if (available < batch.size())
+            {
+                cachedTail = tail.load(std::memory_order_acquire);
+                available = cachedTail - position;
+            }
+            std::size_t count = available < batch.size() ? available : batch.size();
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                batch[index] = std::move(values[(position + index) & mask]);
+            }
+            if (count != 0)
+            {
+                head.store(position + count, std::memory_order_release);
+            }
+            return count;
+        }
+    };
+}
@@ -0,0 +1,299 @@
+#include "DecimalFraction.hpp"
+#include "FractionWide.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ariel
+{
+    namespace
+    {
+        const std::int64_t DECIMAL_BASE = 10;
+        const std::int64_t FLOAT_SCALE = 1000;
+        const unsigned FLOAT_DIGITS = 3;
+        const std::size_t MAX_TEXT_LENGTH = 24;
+
+        constexpr std::array<std::int64_t, DecimalFraction::MAX_EXPONENT + 1> POWERS_OF_TEN = []()
+        {
+            std::array<std::int64_t, DecimalFraction::MAX_EXPONENT + 1> powers{};
+            powers[0] = 1;
+            for (std::size_t i = 1; i < powers.size(); ++i)
+            {
+                powers[i] = powers[i - 1] * DECIMAL_BASE;
+            }
+            return powers;
+        }();
+
+        std::int64_t checkedMultiply(std::int64_t left, std::int64_t right)
+        {
+            std::int64_t result = 0;
+            if (__builtin_mul_overflow(left, right, &result))
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            return result;
+        }
+
+        std::int64_t checkedAdd(std::int64_t left, std::int64_t right)
+        {
+            std::int64_t result = 0;
+            if (__builtin_add_overflow(left, right, &result))
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            return result;
+        }
+
+        /// the exponent of the 10^e denominator that a denominator of the form 2^a * 5^b divides, or -1
+        int decimalExponentOf(wide_int denominator)
+        {
+            int twos = 0;
+            int fives = 0;
+            while (denominator % 2 == 0)
+            {
+                denominator /= 2;
+                ++twos;
+            }
+            while (denominator % 5 == 0)
+            {
+                denominator /= 5;
+                ++fives;
+            }
+            return denominator == 1 ? std::max(twos, fives) : -1;
+        }
+
+        /// exact decimal form of numerator / denominator, the denominator must be positive
+        DecimalFraction fromRational(WideRational value)
+        {
+            value.reduce();
+            int exponent = decimalExponentOf(value.denominator);
+            if (exponent < 0)
+            {
+                throw std::domain_error("Value is not a terminating decimal");
+            }
+            if (exponent > (int)DecimalFraction::MAX_EXPONENT)
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            // the reduced numerator of a quotient can take up to 123 bits, so the scaling itself may overflow
+            wide_int mantissa = 0;
+            if (__builtin_mul_overflow(value.numerator, POWERS_OF_TEN[(std::size_t)exponent] / value.denominator, &mantissa) ||
+                mantissa > std::numeric_limits<std::int64_t>::max() || mantissa < std::numeric_limits<std::int64_t>::min())
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            return DecimalFraction(static_cast<std::int64_t>(mantissa), (unsigned)exponent);
+        }
+
+        template <typename Real>
+        DecimalFraction fromReal(Real number)
+        {
+            std::int64_t sign = (number < 0) ? -1 : 1;
+            number = std::abs(number);
+            auto whole = (std::int64_t)number;
+            auto decimal = (std::int64_t)std::round((number - (Real)whole) * FLOAT_SCALE);
+            return DecimalFraction((whole * FLOAT_SCALE + decimal) * sign, FLOAT_DIGITS);
+        }
+    }
+
+    void DecimalFraction::normalize()
+    {
+        while (exponent > 0 && mantissa % DECIMAL_BASE == 0)
+        {
+            mantissa /= DECIMAL_BASE;
+            --exponent;
+        }
+        if (mantissa == 0)
+        {
+            exponent = 0;
+        }
+    }
+
+    DecimalFraction::DecimalFraction() : mantissa(0), exponent(0) {}
+
+    DecimalFraction::DecimalFraction(std::int64_t mantissaVal, unsigned exponentVal) : mantissa(mantissaVal), exponent(0)
+    {
+        if (exponentVal > MAX_EXPONENT)
+        {
+            throw std::invalid_argument("Exponent is too large");
+        }
+        exponent = (std::uint8_t)exponentVal;
+        normalize();
+    }
+
+    DecimalFraction::DecimalFraction(int integerVal) : mantissa(integerVal), exponent(0) {}
+
+    DecimalFraction::DecimalFraction(float floatNumber) : DecimalFraction(fromReal(floatNumber)) {}
+
+    DecimalFraction::DecimalFraction(double doubleNumber) : DecimalFraction(fromReal(doubleNumber)) {}
+
+    DecimalFraction::DecimalFraction(const Fraction &fraction) : mantissa(0), exponent(0)
+    {
+        if (decimalExponentOf(fraction.getDenominator()) < 0)
+        {
+            throw std::invalid_argument("Fraction is not a terminating decimal");
+        }
+        *this = fromRational(WideRational{fraction.getNumerator(), fraction.getDenominator()});
+    }
+
+    Fraction DecimalFraction::toFraction() const
+    {
+        return WideRational{mantissa, POWERS_OF_TEN[exponent]}.toFraction();
+    }
+
+    std::int64_t DecimalFraction::getMantissa() const
+    {
+        return mantissa;
+    }
+
+    unsigned DecimalFraction::getExponent() const
+    {
+        return exponent;
+    }
+
+    std::optional<DecimalFraction> DecimalFraction::parse(std::string_view text)
+    {
+        std::size_t position = 0;
+        bool negative = false;
+        if (position < text.size() && (text[position] == '-' || text[position] == '+'))
+        {
+            negative = text[position] == '-';
+            ++position;
+        }
+        std::uint64_t magnitude = 0;
+        std::size_t digits = 0;
+        unsigned fractionDigits = 0;
+        bool point = false;
+        for (; position < text.size(); ++position)
+        {
+            char character = text[position];
+            if (character == '.' && !point)
+            {
+                point = true;
+                continue;
+            }
+            if (character < '0' || character > '9')
+            {
+                return std::nullopt;
+            }
+            if (__builtin_mul_overflow(magnitude, std::uint64_t(DECIMAL_BASE), &magnitude) ||
+                __builtin_add_overflow(magnitude, std::uint64_t(character - '0'), &magnitude))
+            {
+                return std::nullopt;
+            }
+            ++digits;
+            fractionDigits += point ? 1 : 0;
+        }
+        const std::uint64_t limit = std::uint64_t(std::numeric_limits<std::int64_t>::max()) + (negative ? 1 : 0);
+        if (digits == 0 || fractionDigits > MAX_EXPONENT || magnitude > limit)
+        {
+            return std::nullopt;
+        }
+        auto mantissaVal = negative ? (std::int64_t)(std::uint64_t(0) - magnitude) : (std::int64_t)magnitude;
+        return DecimalFraction(mantissaVal, fractionDigits);
+    }
+
+    char *DecimalFraction::toChars(char *first, char *last) const
+    {
+        std::array<char, MAX_TEXT_LENGTH> reversed{};
+        std::size_t length = 0;
+        std::uint64_t magnitude = mantissa < 0 ? std::uint64_t(0) - (std::uint64_t)mantissa : (std::uint64_t)mantissa;
+        for (unsigned digit = 0; digit < exponent; ++digit)
+        {
+            reversed[length++] = (char)('0' + magnitude % DECIMAL_BASE);
+            magnitude /= DECIMAL_BASE;
+        }
+        if (exponent > 0)
+        {
+            reversed[length++] = '.';
+        }
+        do
+        {
+            reversed[length++] = (char)('0' + magnitude % DECIMAL_BASE);
+            magnitude /= DECIMAL_BASE;
+        } while (magnitude != 0);
+        if (mantissa < 0)
+        {
+            reversed[length++] = '-';
+        }
+        if (last - first < (std::ptrdiff_t)length)
+        {
+            return nullptr;
+        }
+        return std::reverse_copy(reversed.begin(), reversed.begin() + (std::ptrdiff_t)length, first);
+    }
+
+    std::string DecimalFraction::toString() const
+    {
+        std::array<char, MAX_TEXT_LENGTH> buffer{};
+        char *end = toChars(buffer.begin(), buffer.end());
+        return std::string(buffer.begin(), end);
+    }
+
+    DecimalFraction &DecimalFraction::operator+=(const DecimalFraction &right)
+    {
+        unsigned common = std::max(exponent, right.exponent);
+        std::int64_t leftScaled = checkedMultiply(mantissa, POWERS_OF_TEN[common - exponent]);
+        std::int64_t rightScaled = checkedMultiply(right.mantissa, POWERS_OF_TEN[common - right.exponent]);
+        return *this = DecimalFraction(checkedAdd(leftScaled, rightScaled), common);
+    }
+
+    DecimalFraction &DecimalFraction::operator-=(const DecimalFraction &right)
+    {
+        if (right.mantissa == std::numeric_limits<std::int64_t>::min())
+        {
+            throw std::overflow_error("Overflow error");
+        }
+        return *this += DecimalFraction(-right.mantissa, right.exponent);
+    }
+
+    DecimalFraction &DecimalFraction::operator*=(const DecimalFraction &right)
+    {
+        std::int64_t product = checkedMultiply(mantissa, right.mantissa);
+        unsigned productExponent = exponent + right.exponent;
+        while (productExponent > MAX_EXPONENT && product % DECIMAL_BASE == 0)
+        {
+            product /= DECIMAL_BASE;
+            --productExponent;
+        }
+        if (productExponent > MAX_EXPONENT)
+        {
+            throw std::overflow_error("Overflow error");
+        }
+        return *this = DecimalFraction(product, productExponent);
+    }
+
+    DecimalFraction &DecimalFraction::operator/=(const DecimalFraction &right)
+    {
+        if (right.mantissa == 0)
+        {
+            throw std::runtime_error("Cannot divide by zero");
+        }
+        // |int64| * 10^18 < 2^123, so both scaled mantissas fit in wide_int
+        WideRational quotient{(wide_int)mantissa * POWERS_OF_TEN[right.exponent], (wide_int)right.mantissa * POWERS_OF_TEN[exponent]};
+        if (quotient.denominator < 0)
+        {
+            quotient.numerator = -quotient.numerator;
+            quotient.denominator = -quotient.denominator;
+        }
+        return *this = fromRational(quotient);
+    }
+
+    int DecimalFraction::compare(const DecimalFraction &left, const DecimalFraction &right)
+    {
+        unsigned common = std::max(left.exponent, right.exponent);
+        // bounded like the quotient in operator/=, no overflow check needed
+        wide_int leftScaled = (wide_int)left.mantissa * POWERS_OF_TEN[common - left.exponent];
+        wide_int rightScaled = (wide_int)right.mantissa * POWERS_OF_TEN[common - right.exponent];
+        return (leftScaled > rightScaled) - (leftScaled < rightScaled);
+    }
+
+    std::ostream &operator<<(std::ostream &outputStream, const DecimalFraction &decimal)
+    {
+        std::array<char, MAX_TEXT_LENGTH> buffer{};
+        char *end = decimal.toChars(buffer.begin(), buffer.end());
+        return outputStream.write(buffer.data(), end - buffer.data());
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "Fraction.hpp"
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace ariel
+{
+    /// @brief
+    /// Decimal fixed point value mantissa / 10^exponent for data that comes from decimal text or from
+    /// the 3 digit float conversion. Arithmetic uses integer operations only and never a general gcd,
+    /// the value is kept canonical by stripping trailing zeros of the mantissa.
+    class DecimalFraction
+    {
+    private:
+        std::int64_t mantissa;
+        std::uint8_t exponent;
+
+        void normalize();
+
+    public:
+        /// @brief the largest supported exponent, 10^18 still fits in 64 bits
+        static const unsigned MAX_EXPONENT = 18;
+
+        /// @brief default constructor, value 0
+        DecimalFraction();
+
+        /// @brief constructor for the value mantissaVal / 10^exponentVal
+        /// @param mantissaVal the decimal digits
+        /// @param exponentVal number of digits after the point, throws invalid_argument above MAX_EXPONENT
+        DecimalFraction(std::int64_t mantissaVal, unsigned exponentVal = 0);
+
+        /// @brief constructor for an integer value, avoids the ambiguity with the float constructors
+        DecimalFraction(int integerVal);
+
+        /// @brief constructor from a float with 3 digits after the point, like the Fraction constructor
+        explicit DecimalFraction(float floatNumber);
+
+        /// @brief constructor from a double with 3 digits after the point, like the Fraction constructor
+        explicit DecimalFraction(double doubleNumber);
+
+        /// @brief exact conversion from Fraction
+        /// @param fraction Fraction object whose denominator has no prime factors but 2 and 5 else throws invalid_argument
+        explicit DecimalFraction(const Fraction &fraction);
+
+        /// @brief exact conversion to a reduced Fraction, throws overflow_error if it does not fit
+        Fraction toFraction() const;
+
+        /// @brief gives the mantissa
+        std::int64_t getMantissa() const;
+
+        /// @brief gives the number of digits after the point
+        unsigned getExponent() const;
+
+        /// @brief parse optional sign, digits and an optional point followed by digits, e.g. "-12.345"
+        /// @param text the whole text to parse, without surrounding spaces
+        /// @return the value, nothing if the text is malformed or does not fit
+        static std::optional<DecimalFraction> parse(std::string_view text);
+
+        /// @brief write the value in decimal notation into a buffer
+        /// @return pointer past the last written character, nullptr if the buffer is too small
+        char *toChars(char *first, char *last) const;
+
+        /// @brief the value in decimal notation, e.g. "-12.345"
+        std::string toString() const;
+
+        DecimalFraction &operator+=(const DecimalFraction &right);
+        DecimalFraction &operator-=(const DecimalFraction &right);
+        DecimalFraction &operator*=(const DecimalFraction &right);
+
+        /// @brief exact division, throws runtime_error when dividing by 0 and domain_error if the quotient does not terminate
+        DecimalFraction &operator/=(const DecimalFraction &right);
+
+        friend DecimalFraction operator+(DecimalFraction left, const DecimalFraction &right) { return left += right; }
+        friend DecimalFraction operator-(DecimalFraction left, const DecimalFraction &right) { return left -= right; }
+        friend DecimalFraction operator*(DecimalFraction left, const DecimalFraction &right) { return left *= right; }
+        friend DecimalFraction operator/(DecimalFraction left, const DecimalFraction &right) { return left /= right; }
+
+        /// @brief exact three way comparison
+        static int compare(const DecimalFraction &left, const DecimalFraction &right);
+
+        friend bool operator==(const DecimalFraction &left, const DecimalFraction &right)
+        {
+            return left.mantissa == right.mantissa && left.exponent == right.exponent;
+        }
+        friend bool operator!=(const DecimalFraction &left, const DecimalFraction &right) { return !(left == right); }
+        friend bool operator<(const DecimalFraction &left, const DecimalFraction &right) { return compare(left, right) < 0; }
+        friend bool operator<=(const DecimalFraction &left, const DecimalFraction &right) { return compare(left, right) <= 0; }
+        friend bool operator>(const DecimalFraction &left, const DecimalFraction &right) { return compare(left, right) > 0; }
+        friend bool operator>=(const DecimalFraction &left, const DecimalFraction &right) { return compare(left, right) >= 0; }
+
+        /// @brief prints the value in decimal notation
+        friend std::ostream &operator<<(std::ostream &outputStream, const DecimalFraction &decimal);
+    };
+}
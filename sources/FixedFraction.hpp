@@ -0,0 +1,157 @@
+#pragma once
+#include "Fraction.hpp"
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace ariel
+{
+    /// @brief
+    /// Fraction with a compile time denominator Den, e.g. prices in 1/1000 or probabilities in 1/256.
+    /// Only the numerator is stored, so add and subtract are plain checked integer operations and
+    /// multiply and divide rescale by the constant Den, which the compiler turns into multiplications.
+    /// Multiply and divide round half away from zero to the nearest multiple of 1/Den.
+    /// @tparam Den the denominator of every value
+    template <int Den>
+    class FixedFraction
+    {
+        static_assert(Den > 0, "the denominator must be positive");
+
+    private:
+        int numerator;
+
+        /// @brief round numeratorVal / denominatorVal half away from zero, denominatorVal must be positive
+        static long long roundedDivide(long long numeratorVal, long long denominatorVal)
+        {
+            long long quotient = numeratorVal / denominatorVal;
+            long long remainder = numeratorVal % denominatorVal;
+            if (2 * (remainder < 0 ? -remainder : remainder) >= denominatorVal)
+            {
+                quotient += numeratorVal < 0 ? -1 : 1;
+            }
+            return quotient;
+        }
+
+        static FixedFraction checked(long long numeratorVal)
+        {
+            if (numeratorVal > std::numeric_limits<int>::max() || numeratorVal < std::numeric_limits<int>::min())
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            return fromNumerator(static_cast<int>(numeratorVal));
+        }
+
+    public:
+        /// @brief the compile time denominator
+        static constexpr int denominator = Den;
+
+        /// @brief default constructor, value 0
+        FixedFraction() : numerator(0) {}
+
+        /// @brief the value numeratorVal / Den
+        static FixedFraction fromNumerator(int numeratorVal)
+        {
+            FixedFraction result;
+            result.numerator = numeratorVal;
+            return result;
+        }
+
+        /// @brief exact conversion from Fraction
+        /// @param fraction Fraction object whose denominator must divide Den else throws invalid_argument
+        explicit FixedFraction(const Fraction &fraction)
+        {
+            if (Den % fraction.getDenominator() != 0)
+            {
+                throw std::invalid_argument("Fraction is not a multiple of 1/Den");
+            }
+            *this = checked((long long)fraction.getNumerator() * (Den / fraction.getDenominator()));
+        }
+
+        /// @brief conversion from Fraction rounded half away from zero to the nearest multiple of 1/Den
+        static FixedFraction rounded(const Fraction &fraction)
+        {
+            return checked(roundedDivide((long long)fraction.getNumerator() * Den, fraction.getDenominator()));
+        }
+
+        /// @brief exact conversion to a reduced Fraction
+        Fraction toFraction() const
+        {
+            return Fraction(numerator, Den);
+        }
+
+        /// @brief explicit conversion to Fraction, see toFraction
+        explicit operator Fraction() const
+        {
+            return toFraction();
+        }
+
+        /// @brief gives the numerator over Den
+        int getNumerator() const
+        {
+            return numerator;
+        }
+
+        FixedFraction &operator+=(const FixedFraction &right)
+        {
+            int result = 0;
+            if (__builtin_add_overflow(numerator, right.numerator, &result))
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            numerator = result;
+            return *this;
+        }
+
+        FixedFraction &operator-=(const FixedFraction &right)
+        {
+            int result = 0;
+            if (__builtin_sub_overflow(numerator, right.numerator, &result))
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            numerator = result;
+            return *this;
+        }
+
+        /// @brief multiply in place, the product is rounded to a multiple of 1/Den
+        FixedFraction &operator*=(const FixedFraction &right)
+        {
+            return *this = checked(roundedDivide((long long)numerator * right.numerator, Den));
+        }
+
+        /// @brief divide in place, the quotient is rounded to a multiple of 1/Den, throws runtime_error when dividing by 0
+        FixedFraction &operator/=(const FixedFraction &right)
+        {
+            if (right.numerator == 0)
+            {
+                throw std::runtime_error("Cannot divide by zero");
+            }
+            long long dividend = (long long)numerator * Den;
+            long long divisor = right.numerator;
+            if (divisor < 0)
+            {
+                dividend = -dividend;
+                divisor = -divisor;
+            }
+            return *this = checked(roundedDivide(dividend, divisor));
+        }
+
+        friend FixedFraction operator+(FixedFraction left, const FixedFraction &right) { return left += right; }
+        friend FixedFraction operator-(FixedFraction left, const FixedFraction &right) { return left -= right; }
+        friend FixedFraction operator*(FixedFraction left, const FixedFraction &right) { return left *= right; }
+        friend FixedFraction operator/(FixedFraction left, const FixedFraction &right) { return left /= right; }
+
+        friend bool operator==(const FixedFraction &left, const FixedFraction &right) { return left.numerator == right.numerator; }
+        friend bool operator!=(const FixedFraction &left, const FixedFraction &right) { return left.numerator != right.numerator; }
+        friend bool operator<(const FixedFraction &left, const FixedFraction &right) { return left.numerator < right.numerator; }
+        friend bool operator<=(const FixedFraction &left, const FixedFraction &right) { return left.numerator <= right.numerator; }
+        friend bool operator>(const FixedFraction &left, const FixedFraction &right) { return left.numerator > right.numerator; }
+        friend bool operator>=(const FixedFraction &left, const FixedFraction &right) { return left.numerator >= right.numerator; }
+
+        /// @brief prints the reduced value as "numerator/denominator" like Fraction
+        friend std::ostream &operator<<(std::ostream &outputStream, const FixedFraction &fraction)
+        {
+            return outputStream << fraction.toFraction();
+        }
+    };
+}
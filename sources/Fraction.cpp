@@ -1,4 +1,5 @@
 #include "Fraction.hpp"
+#include "FractionTables.hpp"
 #include <algorithm>
 #include <iostream>
 #include <stdexcept>
@@ -8,6 +9,19 @@
 
 namespace ariel
 {
+    inline void Fraction::reduce()
+    {
+#ifndef FRACTION_NO_SMALL_TABLES
+        if (DefaultSmallTables::reduce(numerator, denominator))
+        {
+            return;
+        }
+#endif
+        int gcd = std::gcd(numerator, denominator);
+        numerator /= gcd;
+        denominator /= gcd;
+    }
+
     Fraction::Fraction()
     {
         numerator = 0;
@@ -94,92 +108,85 @@ namespace ariel
         return *this;
     }
 
-    int Fraction::getNumerator()
+    int Fraction::getNumerator() const
     {
         return numerator;
     }
-    int Fraction::getDenominator()
+    int Fraction::getDenominator() const
     {
         return denominator;
     }
 
-    Fraction Fraction::operator+(const Fraction &fractionRight) const
+    void Fraction::assignChecked(long long numeratorVal, long long denominatorVal)
     {
         int max_int = std::numeric_limits<int>::max();
         int min_int = std::numeric_limits<int>::min();
-        long long newNumerator = (long long)numerator * fractionRight.denominator + (long long)fractionRight.numerator * denominator;
-        long long newDenominator = denominator * fractionRight.denominator;
-        if (newNumerator > max_int || newNumerator < min_int || newDenominator > max_int || newDenominator < min_int)
+        if (denominatorVal < 0)
+        {
+            numeratorVal = -numeratorVal;
+            denominatorVal = -denominatorVal;
+        }
+        if (numeratorVal > max_int || numeratorVal < min_int || denominatorVal > max_int)
         {
             throw std::overflow_error("Overflow error");
         }
-        return Fraction(newNumerator, newDenominator);
+        numerator = (int)numeratorVal;
+        denominator = (int)denominatorVal;
+        reduce();
+    }
+
+    Fraction Fraction::operator+(const Fraction &fractionRight) const
+    {
+        Fraction result(*this);
+        result += fractionRight;
+        return result;
     }
 
     Fraction Fraction::operator-(const Fraction &fractionRight) const
     {
-        int max_int = std::numeric_limits<int>::max();
-        int min_int = std::numeric_limits<int>::min();
-        long long newNumerator = (long long)numerator * fractionRight.denominator - (long long)fractionRight.numerator * denominator;
-        long long newDenominator = denominator * fractionRight.denominator;
-        if (newNumerator > max_int || newNumerator < min_int || newDenominator > max_int || newDenominator < min_int)
-        {
-            throw std::overflow_error("Overflow error");
-        }
-        return Fraction(newNumerator, newDenominator);
+        Fraction result(*this);
+        result -= fractionRight;
+        return result;
     }
 
     Fraction Fraction::operator*(const Fraction &fractionRight) const
     {
-        int newNumerator = numerator * fractionRight.numerator;
-        int newDenominator = denominator * fractionRight.denominator;
-          if (((numerator != 0) && (newNumerator / numerator != fractionRight.numerator)) ||
-            ((denominator != 0) && (newDenominator / denominator != fractionRight.denominator)))
-        {
-            throw std::overflow_error("Overflow error");
-        }
-        
-        
-        return Fraction(newNumerator, newDenominator);
+        Fraction result(*this);
+        result *= fractionRight;
+        return result;
     }
 
     Fraction Fraction::operator/(const Fraction &fractionRight) const
     {
-        if (fractionRight.numerator == 0)
-        {
-            throw std::runtime_error("Cannot divide by zero");
-        }
-        int newNumerator = numerator * fractionRight.denominator;
-        int newDenominator = denominator * fractionRight.numerator;
-        if (((numerator != 0) && (newNumerator / numerator != fractionRight.denominator)) ||
-            ((denominator != 0) && (newDenominator / denominator != fractionRight.numerator)))
-        {
-            throw std::overflow_error("Overflow error");
-        }
-        return Fraction(newNumerator, newDenominator);
+        Fraction result(*this);
+        result /= fractionRight;
+        return result;
     }
-    Fraction Fraction::operator+=(const Fraction &fractionRight)
+
+    Fraction &Fraction::operator+=(const Fraction &fractionRight)
     {
-        *this = *this + fractionRight;
+        assignChecked((long long)numerator * fractionRight.denominator + (long long)fractionRight.numerator * denominator,
+                      (long long)denominator * fractionRight.denominator);
         return *this;
     }
-    Fraction Fraction::operator-=(const Fraction &fractionRight)
+    Fraction &Fraction::operator-=(const Fraction &fractionRight)
     {
-        *this = *this - fractionRight;
+        assignChecked((long long)numerator * fractionRight.denominator - (long long)fractionRight.numerator * denominator,
+                      (long long)denominator * fractionRight.denominator);
         return *this;
     }
-    Fraction Fraction::operator*=(const Fraction &fractionRight)
+    Fraction &Fraction::operator*=(const Fraction &fractionRight)
     {
-        *this = *this * fractionRight;
+        assignChecked((long long)numerator * fractionRight.numerator, (long long)denominator * fractionRight.denominator);
         return *this;
     }
-    Fraction Fraction::operator/=(const Fraction &fractionRight)
+    Fraction &Fraction::operator/=(const Fraction &fractionRight)
     {
         if (fractionRight.numerator == 0)
         {
             throw std::runtime_error("Cannot divide by zero");
         }
-        *this = *this / fractionRight;
+        assignChecked((long long)numerator * fractionRight.denominator, (long long)denominator * fractionRight.numerator);
         return *this;
     }
 
@@ -273,17 +280,20 @@ namespace ariel
     Fraction operator+(float floatNumberLeft, const Fraction &fractionRight)
     {
         Fraction left(floatNumberLeft);
-        return left + fractionRight;
+        left += fractionRight;
+        return left;
     }
     Fraction operator-(float floatNumberLeft, const Fraction &fractionRight)
     {
         Fraction left(floatNumberLeft);
-        return left - fractionRight;
+        left -= fractionRight;
+        return left;
     }
     Fraction operator*(float floatNumberLeft, const Fraction &fractionRight)
     {
         Fraction left(floatNumberLeft);
-        return left * fractionRight;
+        left *= fractionRight;
+        return left;
     }
     Fraction operator/(float floatNumberLeft, const Fraction &fractionRight)
     {
@@ -293,7 +303,8 @@ namespace ariel
         }
 
         Fraction left(floatNumberLeft);
-        return left / fractionRight;
+        left /= fractionRight;
+        return left;
     }
 
     std::ostream &operator<<(std::ostream &outputStream, const Fraction &fractionNumber)
@@ -334,52 +345,48 @@ namespace ariel
 
     Fraction Fraction::operator+(float floatNumberRight) const
     {
-        Fraction right(floatNumberRight);
-        return *this + right;
+        Fraction result(*this);
+        result += floatNumberRight;
+        return result;
     }
     Fraction Fraction::operator-(float floatNumberRight) const
     {
-        Fraction right(floatNumberRight);
-        return *this - right;
+        Fraction result(*this);
+        result -= floatNumberRight;
+        return result;
     }
     Fraction Fraction::operator*(float floatNumberRight) const
     {
-        Fraction right(floatNumberRight);
-        return *this * right;
+        Fraction result(*this);
+        result *= floatNumberRight;
+        return result;
     }
     Fraction Fraction::operator/(float floatNumberRight) const
     {
-        if (floatNumberRight == 0)
-        {
-            throw std::runtime_error("Cannot divide by zero");
-        }
-        Fraction right(floatNumberRight);
-        return *this / right;
+        Fraction result(*this);
+        result /= floatNumberRight;
+        return result;
     }
 
-    Fraction Fraction::operator+=(float floatNumberRight)
+    Fraction &Fraction::operator+=(float floatNumberRight)
     {
-        *this = *this + floatNumberRight;
-        return *this;
+        return *this += Fraction(floatNumberRight);
     }
-    Fraction Fraction::operator-=(float floatNumberRight)
+    Fraction &Fraction::operator-=(float floatNumberRight)
     {
-        *this = *this - floatNumberRight;
-        return *this;
+        return *this -= Fraction(floatNumberRight);
     }
-    Fraction Fraction::operator*=(float floatNumberRight)
+    Fraction &Fraction::operator*=(float floatNumberRight)
     {
-        *this = *this * floatNumberRight;
-        return *this;
+        return *this *= Fraction(floatNumberRight);
     }
-    Fraction Fraction::operator/=(float floatNumberRight)
+    Fraction &Fraction::operator/=(float floatNumberRight)
     {
         if (floatNumberRight == 0)
         {
             throw std::runtime_error("Cannot divide by zero");
         }
-        *this = *this / floatNumberRight;
-        return *this;
+        return *this /= Fraction(floatNumberRight);
     }
 
     Fraction Fraction::operator++(int)
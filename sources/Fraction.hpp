@@ -10,17 +10,30 @@
 #include <iterator>
 namespace ariel
 {
+    struct WideRational;
+
     class Fraction
     {
     private:
         int numerator;
         int denominator;
-        void reduce()
+
+        /// @brief tag selecting the constructor for values that are already reduced
+        struct ReducedTag
         {
-            int gcd = std::gcd(numerator, denominator);
-            numerator /= gcd;
-            denominator /= gcd;
-        }
+        };
+
+        /// @brief constructor for values that are already reduced and normalized, skips validation
+        Fraction(ReducedTag /*tag*/, int numeratorVal, int denominatorVal) : numerator(numeratorVal), denominator(denominatorVal) {}
+
+        friend struct WideRational;
+
+        /// @brief store an unreduced result computed in long long, normalizing the sign and reducing it
+        /// throws overflow_error if a component does not fit in int
+        void assignChecked(long long numeratorVal, long long denominatorVal);
+
+        /// @brief divide numerator and denominator by their gcd, small values go through SmallFractionTables
+        void reduce();
 
     public:
         /// @brief
@@ -112,23 +125,23 @@ namespace ariel
 
         /// @brief add Fraction object to the current Fraction object
         /// @param fractionRight Fraction object to add
-        /// @return the result of the addition
-        Fraction operator+=(const Fraction &fractionRight);
+        /// @return Fraction& reference to the current Fraction object holding the result of the addition
+        Fraction &operator+=(const Fraction &fractionRight);
 
         /// @brief subtract the current Fraction object from Fraction object
         /// @param fractionRight Fraction object to subtract
-        /// @return the result of the subtraction
-        Fraction operator-=(const Fraction &fractionRight);
+        /// @return Fraction& reference to the current Fraction object holding the result of the subtraction
+        Fraction &operator-=(const Fraction &fractionRight);
 
         /// @brief multiply Fraction object with the current Fraction object
         /// @param fractionRight Fraction object to multiply
-        /// @return the result of the multiplication
-        Fraction operator*=(const Fraction &fractionRight);
+        /// @return Fraction& reference to the current Fraction object holding the result of the multiplication
+        Fraction &operator*=(const Fraction &fractionRight);
 
         /// @brief divide the current Fraction object from Fraction object
         /// @param fractionRight Fraction object to divide if the Fraction object is 0 throws exception
-        /// @return the result of the division
-        Fraction operator/=(const Fraction &fractionRight);
+        /// @return Fraction& reference to the current Fraction object holding the result of the division
+        Fraction &operator/=(const Fraction &fractionRight);
 
         /// @brief check if the current Fraction object is equal to the Fraction object
         /// @return true if the Fraction objects are equal else false
@@ -235,29 +248,29 @@ namespace ariel
         Fraction operator/(float floatNumberRight) const;
 
         /// @brief add float number to the current Fraction object
-        /// @return the result of the addition
-        Fraction operator+=(float floatNumberRight);
+        /// @return Fraction& reference to the current Fraction object holding the result of the addition
+        Fraction &operator+=(float floatNumberRight);
 
         /// @brief subtract float number from the current Fraction object
-        /// @return the result of the subtraction
-        Fraction operator-=(float floatNumberRight);
+        /// @return Fraction& reference to the current Fraction object holding the result of the subtraction
+        Fraction &operator-=(float floatNumberRight);
 
         /// @brief multiply float number with the current Fraction object
-        /// @return the result of the multiplication
-        Fraction operator*=(float floatNumberRight);
+        /// @return Fraction& reference to the current Fraction object holding the result of the multiplication
+        Fraction &operator*=(float floatNumberRight);
 
         /// @brief divide the current Fraction object from float number
-        /// @return the result of the division throws exception if the float number is 0
-        Fraction operator/=(float floatNumberRight);
+        /// @return Fraction& reference to the current Fraction object holding the result of the division throws exception if the float number is 0
+        Fraction &operator/=(float floatNumberRight);
 
 
         /// @brief gives the numerator of the Fraction object
         /// @return int the numerator of the Fraction object
-        int getNumerator();
+        int getNumerator() const;
 
         /// @brief gives the denominator of the Fraction object
         /// @return int the denominator of the Fraction object
-        int getDenominator();
+        int getDenominator() const;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include "FractionBinary.hpp"
+#include "FractionWide.hpp"
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+namespace ariel
+{
+    namespace
+    {
+        const std::array<unsigned char, 4> MAGIC{'F', 'R', 'C', 'B'};
+        const std::size_t HEADER_BYTES = 8;
+        const std::size_t BLOCK_HEADER_BYTES = 12;
+        const std::size_t END_PAYLOAD_BYTES = 8;
+        /// longest record, two 5 byte varints
+        const std::size_t MAX_RECORD_BYTES = 10;
+        /// blocks claiming a larger payload are treated as corrupt instead of being allocated
+        const std::uint32_t MAX_PAYLOAD_BYTES = std::uint32_t(1) << 28;
+        const unsigned VARINT_BITS = 7;
+        const unsigned char VARINT_MORE = 0x80;
+        const unsigned char VARINT_MASK = 0x7F;
+        const std::uint32_t CRC_POLYNOMIAL = 0xEDB88320U;
+
+        const std::size_t CRC_SLICES = 8;
+        using CrcTables = std::array<std::array<std::uint32_t, 256>, CRC_SLICES>;
+
+        /// slicing-by-8 tables, table[k][b] is the CRC of byte b followed by k zero bytes
+        constexpr CrcTables makeCrcTables()
+        {
+            CrcTables tables{};
+            for (std::uint32_t index = 0; index < 256; ++index)
+            {
+                std::uint32_t value = index;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    value = (value & 1U) != 0 ? (value >> 1) ^ CRC_POLYNOMIAL : value >> 1;
+                }
+                tables[0][index] = value;
+            }
+            for (std::size_t slice = 1; slice < CRC_SLICES; ++slice)
+            {
+                for (std::size_t index = 0; index < 256; ++index)
+                {
+                    std::uint32_t previous = tables[slice - 1][index];
+                    tables[slice][index] = (previous >> 8) ^ tables[0][previous & 0xFFU];
+                }
+            }
+            return tables;
+        }
+
+        constexpr CrcTables CRC_TABLES = makeCrcTables();
+
+        std::uint64_t zigzag(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        std::int64_t unzigzag(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1U);
+        }
+
+        unsigned char *putVarint(unsigned char *output, std::uint64_t value)
+        {
+            while (value >= VARINT_MORE)
+            {
+                *output++ = static_cast<unsigned char>(value | VARINT_MORE);
+                value >>= VARINT_BITS;
+            }
+            *output++ = static_cast<unsigned char>(value);
+            return output;
+        }
+
+        /// decode a varint of at most 64 bits from [position, last), false if it is truncated or too long
+        bool getVarint(const unsigned char *&position, const unsigned char *last, std::uint64_t &value)
+        {
+            value = 0;
+            for (unsigned shift = 0; shift < 64 && position != last; shift += VARINT_BITS)
+            {
+                unsigned char byte = *position++;
+                value |= static_cast<std::uint64_t>(byte & VARINT_MASK) << shift;
+                if ((byte & VARINT_MORE) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void putUint32(unsigned char *output, std::uint32_t value)
+        {
+            for (int byte = 0; byte < 4; ++byte)
+            {
+                output[byte] = static_cast<unsigned char>(value >> (8 * byte));
+            }
+        }
+
+        std::uint32_t getUint32(const unsigned char *input)
+        {
+            std::uint32_t value = 0;
+            for (int byte = 0; byte < 4; ++byte)
+            {
+                value |= static_cast<std::uint32_t>(input[byte]) << (8 * byte);
+            }
+            return value;
+        }
+
+        void readExactly(std::istream &input, unsigned char *data, std::size_t size)
+        {
+            input.read(reinterpret_cast<char *>(data), static_cast<std::streamsize>(size));
+            if (static_cast<std::size_t>(input.gcount()) != size)
+            {
+                throw std::runtime_error("Truncated fraction column");
+            }
+        }
+
+        [[noreturn]] void corrupt()
+        {
+            throw std::runtime_error("Corrupt fraction column");
+        }
+    }
+
+    std::uint32_t crc32(std::span<const unsigned char> bytes)
+    {
+        const unsigned char *data = bytes.data();
+        std::size_t size = bytes.size();
+        std::uint32_t crc = 0xFFFFFFFFU;
+        std::size_t index = 0;
+        for (; index + CRC_SLICES <= size; index += CRC_SLICES)
+        {
+            std::uint32_t low = crc ^ (static_cast<std::uint32_t>(data[index]) | static_cast<std::uint32_t>(data[index + 1]) << 8 |
+                                       static_cast<std::uint32_t>(data[index + 2]) << 16 | static_cast<std::uint32_t>(data[index + 3]) << 24);
+            crc = CRC_TABLES[7][low & 0xFFU] ^ CRC_TABLES[6][(low >> 8) & 0xFFU] ^ CRC_TABLES[5][(low >> 16) & 0xFFU] ^
+                  CRC_TABLES[4][low >> 24] ^ CRC_TABLES[3][data[index + 4]] ^ CRC_TABLES[2][data[index + 5]] ^
+                  CRC_TABLES[1][data[index + 6]] ^ CRC_TABLES[0][data[index + 7]];
+        }
+        for (; index < size; ++index)
+        {
+            crc = CRC_TABLES[0][(crc ^ data[index]) & 0xFFU] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    FractionBinaryWriter::FractionBinaryWriter(std::ostream &outputStream, std::uint32_t blockSize)
+        : output(outputStream), recordsPerBlock(blockSize == 0 ? 1 : blockSize)
+    {
+        std::array<unsigned char, HEADER_BYTES> header{MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3], FRACTION_BINARY_VERSION, 0, 0, 0};
+        output.write(reinterpret_cast<const char *>(header.data()), header.size());
+        payload.resize(std::size_t(recordsPerBlock) * MAX_RECORD_BYTES);
+    }
+
+    void FractionBinaryWriter::write(const Fraction &value)
+    {
+        if (finished)
+        {
+            throw std::logic_error("Fraction column is already finished");
+        }
+        unsigned char *position = payload.data() + used;
+        std::uint64_t tag = value.getDenominator() == 1 ? 0 : 1;
+        position = putVarint(position, zigzag(value.getNumerator()) << 1 | tag);
+        if (tag != 0)
+        {
+            position = putVarint(position, static_cast<std::uint64_t>(value.getDenominator()));
+        }
+        used = static_cast<std::size_t>(position - payload.data());
+        if (++blockRecords == recordsPerBlock)
+        {
+            flushBlock();
+        }
+    }
+
+    void FractionBinaryWriter::write(std::span<const Fraction> values)
+    {
+        for (const Fraction &value : values)
+        {
+            write(value);
+        }
+    }
+
+    void FractionBinaryWriter::flushBlock()
+    {
+        std::array<unsigned char, BLOCK_HEADER_BYTES> header{};
+        putUint32(header.data(), blockRecords);
+        putUint32(header.data() + 4, static_cast<std::uint32_t>(used));
+        putUint32(header.data() + 8, crc32(std::span<const unsigned char>(payload.data(), used)));
+        output.write(reinterpret_cast<const char *>(header.data()), header.size());
+        output.write(reinterpret_cast<const char *>(payload.data()), static_cast<std::streamsize>(used));
+        totalRecords += blockRecords;
+        blockRecords = 0;
+        used = 0;
+    }
+
+    void FractionBinaryWriter::finish()
+    {
+        if (finished)
+        {
+            return;
+        }
+        if (blockRecords != 0)
+        {
+            flushBlock();
+        }
+        putUint32(payload.data(), static_cast<std::uint32_t>(totalRecords));
+        putUint32(payload.data() + 4, static_cast<std::uint32_t>(totalRecords >> 32));
+        used = END_PAYLOAD_BYTES;
+        flushBlock();
+        finished = true;
+    }
+
+    FractionBinaryReader::FractionBinaryReader(std::istream &inputStream) : input(inputStream)
+    {
+        std::array<unsigned char, HEADER_BYTES> header{};
+        readExactly(input, header.data(), header.size());
+        if (!std::equal(MAGIC.begin(), MAGIC.end(), header.begin()))
+        {
+            throw std::runtime_error("Not a fraction column");
+        }
+        if (header[4] != FRACTION_BINARY_VERSION)
+        {
+            throw std::runtime_error("Unsupported fraction column version");
+        }
+    }
+
+    bool FractionBinaryReader::loadBlock()
+    {
+        std::array<unsigned char, BLOCK_HEADER_BYTES> header{};
+        readExactly(input, header.data(), header.size());
+        std::uint32_t records = getUint32(header.data());
+        std::uint32_t bytes = getUint32(header.data() + 4);
+        if (bytes > MAX_PAYLOAD_BYTES || (records == 0 && bytes != END_PAYLOAD_BYTES))
+        {
+            corrupt();
+        }
+        payload.resize(bytes);
+        readExactly(input, payload.data(), bytes);
+        if (crc32(std::span<const unsigned char>(payload.data(), bytes)) != getUint32(header.data() + 8))
+        {
+            corrupt();
+        }
+        position = 0;
+        if (records == 0)
+        {
+            std::uint64_t expected = getUint32(payload.data()) | static_cast<std::uint64_t>(getUint32(payload.data() + 4)) << 32;
+            if (expected != totalRecords)
+            {
+                corrupt();
+            }
+            ended = true;
+            return false;
+        }
+        blockRemaining = records;
+        totalRecords += records;
+        return true;
+    }
+
+    std::size_t FractionBinaryReader::read(std::span<Fraction> values)
+    {
+        const long long max_int = std::numeric_limits<int>::max();
+        const long long min_int = std::numeric_limits<int>::min();
+        std::size_t count = 0;
+        while (count < values.size())
+        {
+            if (blockRemaining == 0)
+            {
+                if (ended || !loadBlock())
+                {
+                    break;
+                }
+            }
+            const unsigned char *cursor = payload.data() + position;
+            const unsigned char *last = payload.data() + payload.size();
+            for (; blockRemaining != 0 && count < values.size(); --blockRemaining, ++count)
+            {
+                std::uint64_t head = 0;
+                std::uint64_t denominator = 1;
+                if (!getVarint(cursor, last, head) || ((head & 1U) != 0 && !getVarint(cursor, last, denominator)))
+                {
+                    corrupt();
+                }
+                std::int64_t numerator = unzigzag(head >> 1);
+                if (numerator < min_int || numerator > max_int || denominator == 0 || denominator > (std::uint64_t)max_int ||
+                    WideRational::gcd(numerator, denominator) != 1)
+                {
+                    corrupt();
+                }
+                values[count] = WideRational::trusted(static_cast<int>(numerator), static_cast<int>(denominator));
+            }
+            if (blockRemaining == 0 && cursor != last)
+            {
+                corrupt();
+            }
+            position = static_cast<std::size_t>(cursor - payload.data());
+        }
+        return count;
+    }
+
+    void write_fraction_column(std::ostream &output, std::span<const Fraction> values)
+    {
+        FractionBinaryWriter writer(output);
+        writer.write(values);
+        writer.finish();
+    }
+
+    std::vector<Fraction> read_fraction_column(std::istream &input)
+    {
+        const std::size_t batch = 4096;
+        FractionBinaryReader reader(input);
+        std::vector<Fraction> values;
+        std::size_t count = 0;
+        do
+        {
+            values.resize(values.size() + batch);
+            count = reader.read(std::span<Fraction>(values).subspan(values.size() - batch));
+            values.resize(values.size() - batch + count);
+        } while (count == batch);
+        return values;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "Fraction.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace ariel
+{
+    /// @brief version written into the header of a binary fraction column
+    const std::uint8_t FRACTION_BINARY_VERSION = 1;
+
+    /// @brief CRC-32 (IEEE 802.3) of a byte range, the checksum of the binary fraction formats
+    std::uint32_t crc32(std::span<const unsigned char> bytes);
+
+    /// @brief
+    /// Streaming encoder of the binary fraction column format. Layout, all integers little endian:
+    /// an 8 byte header "FRCB", version, 3 reserved bytes, then blocks of
+    /// [uint32 record count][uint32 payload bytes][uint32 CRC-32 of the payload][payload]
+    /// and a final block with a record count of 0 whose 8 byte payload is the total record count.
+    /// A record is the varint of (zigzag(numerator) << 1 | tag), tag 1 is followed by the varint of the
+    /// denominator, tag 0 means the denominator is 1. Typical values take 2 to 6 bytes instead of
+    /// the 4 to 23 of the text format.
+    class FractionBinaryWriter
+    {
+    private:
+        std::ostream &output;
+        std::vector<unsigned char> payload;
+        std::size_t used = 0;
+        std::uint32_t blockRecords = 0;
+        std::uint32_t recordsPerBlock;
+        std::uint64_t totalRecords = 0;
+        bool finished = false;
+
+        void flushBlock();
+
+    public:
+        /// @brief constructor for a writer that writes the header to the stream
+        /// @param outputStream binary stream that receives the column
+        /// @param blockSize records per checksummed block
+        explicit FractionBinaryWriter(std::ostream &outputStream, std::uint32_t blockSize = 4096);
+
+        FractionBinaryWriter(const FractionBinaryWriter &) = delete;
+        FractionBinaryWriter &operator=(const FractionBinaryWriter &) = delete;
+
+        /// @brief destructor for FractionBinaryWriter. It does not finish the column: a writer destroyed
+        /// before finish, e.g. by an exception, leaves a column without its end block that readers reject
+        ~FractionBinaryWriter() = default;
+
+        /// @brief append one value
+        void write(const Fraction &value);
+
+        /// @brief append a column of values
+        void write(std::span<const Fraction> values);
+
+        /// @brief write the last block and the end block, further writes throw logic_error
+        void finish();
+    };
+
+    /// @brief streaming decoder of the format written by FractionBinaryWriter
+    class FractionBinaryReader
+    {
+    private:
+        std::istream &input;
+        std::vector<unsigned char> payload;
+        std::size_t position = 0;
+        std::uint32_t blockRemaining = 0;
+        std::uint64_t totalRecords = 0;
+        bool ended = false;
+
+        bool loadBlock();
+
+    public:
+        /// @brief constructor for a reader that checks the header of the stream
+        /// @param inputStream binary stream holding a column, throws runtime_error on a bad magic or version
+        explicit FractionBinaryReader(std::istream &inputStream);
+
+        /// @brief decode the next values
+        /// @param values output buffer
+        /// @return number of values decoded, less than values.size() only at the end of the column.
+        /// Throws runtime_error if the data is truncated, corrupt or fails its checksum
+        std::size_t read(std::span<Fraction> values);
+    };
+
+    /// @brief write a whole column in the binary format
+    void write_fraction_column(std::ostream &output, std::span<const Fraction> values);
+
+    /// @brief read a whole column written in the binary format, throws runtime_error on bad data
+    std::vector<Fraction> read_fraction_column(std::istream &input);
+}
@@ -0,0 +1,465 @@
+#include "FractionCompress.hpp"
+#include "FractionBinary.hpp"
+#include "FractionWide.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace ariel
+{
+    namespace
+    {
+        const std::array<char, 4> COLUMN_MAGIC{'F', 'R', 'C', 'Z'};
+        const std::uint64_t COLUMN_VERSION = 1;
+        /// zero bytes after the last block so that the unpack loop may always load 8 bytes
+        const std::size_t LOAD_PADDING = 8;
+        const unsigned VARINT_BITS = 7;
+        const unsigned char VARINT_MORE = 0x80;
+        const unsigned char VARINT_MASK = 0x7F;
+        const unsigned BYTE_BITS = 8;
+        /// widest packed field, an unaligned 8 byte load still covers it after a shift of up to 7 bits
+        const unsigned MAX_PACKED_BITS = 56;
+        /// blocks whose denominators have a larger lcm are stored as runs of equal denominators,
+        /// numerators over a common denominator up to 2^22 keep their differences below 2^55
+        const std::int64_t MAX_COMMON_DENOMINATOR = std::int64_t(1) << 22;
+        const unsigned char DENOMINATOR_RUNS_BLOCK = 0;
+        const unsigned char COMMON_DENOMINATOR_BLOCK = 1;
+
+        std::uint64_t zigzag(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        std::int64_t unzigzag(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1U);
+        }
+
+        void putVarint(std::vector<unsigned char> &output, std::uint64_t value)
+        {
+            while (value >= VARINT_MORE)
+            {
+                output.push_back(static_cast<unsigned char>(value | VARINT_MORE));
+                value >>= VARINT_BITS;
+            }
+            output.push_back(static_cast<unsigned char>(value));
+        }
+
+        [[noreturn]] void corrupt()
+        {
+            throw std::runtime_error("Corrupt compressed fraction column");
+        }
+
+        /// decoded value of a record whose denominator comes from a validated dictionary, the numerator
+        /// is checked since the block checksum does not guarantee the data was written by this encoder
+        Fraction decodedFraction(std::int64_t numerator, int denominator)
+        {
+            if (numerator < std::numeric_limits<int>::min() || numerator > std::numeric_limits<int>::max() ||
+                WideRational::gcd(numerator, denominator) != 1)
+            {
+                corrupt();
+            }
+            return WideRational::trusted(static_cast<int>(numerator), denominator);
+        }
+
+        std::uint64_t getVarint(const unsigned char *&position, const unsigned char *last)
+        {
+            std::uint64_t value = 0;
+            for (unsigned shift = 0; shift < 64 && position != last; shift += VARINT_BITS)
+            {
+                unsigned char byte = *position++;
+                value |= static_cast<std::uint64_t>(byte & VARINT_MASK) << shift;
+                if ((byte & VARINT_MORE) == 0)
+                {
+                    return value;
+                }
+            }
+            corrupt();
+        }
+
+        /// append values of width <= 56 bits, least significant bit first, padded to a whole byte
+        void pack(std::vector<unsigned char> &output, const std::vector<std::uint64_t> &values, unsigned width)
+        {
+            std::size_t first = output.size();
+            std::size_t packedBytes = (values.size() * width + BYTE_BITS - 1) / BYTE_BITS;
+            output.resize(first + packedBytes + sizeof(std::uint64_t));
+            for (std::size_t index = 0; index < values.size(); ++index)
+            {
+                std::size_t bit = index * width;
+                std::uint64_t word = 0;
+                std::memcpy(&word, output.data() + first + bit / BYTE_BITS, sizeof(word));
+                word |= values[index] << (bit % BYTE_BITS);
+                std::memcpy(output.data() + first + bit / BYTE_BITS, &word, sizeof(word));
+            }
+            output.resize(first + packedBytes);
+        }
+
+        /// unpack count values of width <= 56 bits, each iteration is independent so the loop vectorizes
+        void unpack(const unsigned char *input, std::size_t count, unsigned width, std::uint64_t *values)
+        {
+            std::uint64_t mask = width == 0 ? 0 : (~std::uint64_t(0) >> (64 - width));
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                std::size_t bit = index * width;
+                std::uint64_t word = 0;
+                std::memcpy(&word, input + bit / BYTE_BITS, sizeof(word));
+                values[index] = (word >> (bit % BYTE_BITS)) & mask;
+            }
+        }
+
+        /// lcm of the denominators of a block, 0 if it exceeds MAX_COMMON_DENOMINATOR
+        std::int64_t commonDenominator(const std::vector<int> &dictionary)
+        {
+            std::int64_t common = 1;
+            for (int denominator : dictionary)
+            {
+                if (denominator <= 0)
+                {
+                    return 0;
+                }
+                common = std::lcm(common, std::int64_t(denominator));
+                if (common > MAX_COMMON_DENOMINATOR)
+                {
+                    return 0;
+                }
+            }
+            return common;
+        }
+
+        /// append the first value and the differences of its neighbours bit-packed relative to their minimum
+        void putDeltas(std::vector<unsigned char> &output, const std::vector<std::int64_t> &values)
+        {
+            putVarint(output, zigzag(values.front()));
+            if (values.size() == 1)
+            {
+                return;
+            }
+            std::int64_t minDelta = std::numeric_limits<std::int64_t>::max();
+            for (std::size_t index = 1; index < values.size(); ++index)
+            {
+                minDelta = std::min(minDelta, values[index] - values[index - 1]);
+            }
+            std::vector<std::uint64_t> offsets;
+            std::uint64_t maxOffset = 0;
+            for (std::size_t index = 1; index < values.size(); ++index)
+            {
+                offsets.push_back(static_cast<std::uint64_t>(values[index] - values[index - 1] - minDelta));
+                maxOffset = std::max(maxOffset, offsets.back());
+            }
+            auto width = static_cast<unsigned>(std::bit_width(maxOffset));
+            putVarint(output, zigzag(minDelta));
+            output.push_back(static_cast<unsigned char>(width));
+            pack(output, offsets, width);
+        }
+
+        /// decode count values written by putDeltas, scratch holds at least count values
+        void getDeltas(const unsigned char *&position, const unsigned char *last, std::size_t count, std::int64_t *values, std::uint64_t *scratch)
+        {
+            std::int64_t value = unzigzag(getVarint(position, last));
+            values[0] = value;
+            if (count == 1)
+            {
+                return;
+            }
+            std::int64_t minDelta = unzigzag(getVarint(position, last));
+            unsigned width = position != last ? *position++ : 0;
+            std::size_t packedBytes = ((count - 1) * width + BYTE_BITS - 1) / BYTE_BITS;
+            if (width > MAX_PACKED_BITS || packedBytes > static_cast<std::size_t>(last - position))
+            {
+                corrupt();
+            }
+            unpack(position, count - 1, width, scratch);
+            position += packedBytes;
+            // checked adds, crafted deltas must not overflow; the flag keeps the loop free of branches
+            bool overflow = false;
+            for (std::size_t index = 1; index < count; ++index)
+            {
+                std::int64_t delta = 0;
+                overflow |= __builtin_add_overflow(minDelta, static_cast<std::int64_t>(scratch[index - 1]), &delta);
+                overflow |= __builtin_add_overflow(value, delta, &value);
+                values[index] = value;
+            }
+            if (overflow)
+            {
+                corrupt();
+            }
+        }
+
+        void putUint64(std::ostream &output, std::uint64_t value)
+        {
+            std::array<unsigned char, 8> bytes{};
+            for (std::size_t index = 0; index < bytes.size(); ++index)
+            {
+                bytes[index] = static_cast<unsigned char>(value >> (BYTE_BITS * index));
+            }
+            output.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+        }
+
+        std::uint64_t getUint64(std::istream &input)
+        {
+            std::array<unsigned char, 8> bytes{};
+            input.read(reinterpret_cast<char *>(bytes.data()), bytes.size());
+            if (input.gcount() != static_cast<std::streamsize>(bytes.size()))
+            {
+                throw std::runtime_error("Truncated compressed fraction column");
+            }
+            std::uint64_t value = 0;
+            for (std::size_t index = 0; index < bytes.size(); ++index)
+            {
+                value |= static_cast<std::uint64_t>(bytes[index]) << (BYTE_BITS * index);
+            }
+            return value;
+        }
+    }
+
+    CompressedFractionColumn::CompressedFractionColumn(std::span<const Fraction> values, std::size_t blockSize)
+        : valueCount(values.size()), valuesPerBlock(blockSize)
+    {
+        if (blockSize == 0 || blockSize > FRACTION_COMPRESS_MAX_BLOCK)
+        {
+            throw std::invalid_argument("Invalid block size");
+        }
+        for (std::size_t first = 0; first < values.size(); first += blockSize)
+        {
+            blockOffsets.push_back(data.size());
+            encodeBlock(values.subspan(first, std::min(blockSize, values.size() - first)));
+        }
+        data.resize(data.size() + LOAD_PADDING);
+    }
+
+    void CompressedFractionColumn::encodeBlock(std::span<const Fraction> values)
+    {
+        std::vector<int> dictionary;
+        std::unordered_map<int, std::uint64_t> dictionaryIndex;
+        for (const Fraction &value : values)
+        {
+            if (dictionaryIndex.emplace(value.getDenominator(), dictionary.size()).second)
+            {
+                dictionary.push_back(value.getDenominator());
+            }
+        }
+        putVarint(data, values.size());
+        putVarint(data, dictionary.size());
+        for (int denominator : dictionary)
+        {
+            putVarint(data, static_cast<std::uint64_t>(denominator));
+        }
+
+        std::int64_t common = commonDenominator(dictionary);
+        std::vector<std::int64_t> numerators;
+        if (common != 0)
+        {
+            // the whole block is one run over the common denominator, each value keeps its dictionary index
+            data.push_back(COMMON_DENOMINATOR_BLOCK);
+            std::vector<std::uint64_t> indices;
+            for (const Fraction &value : values)
+            {
+                indices.push_back(dictionaryIndex[value.getDenominator()]);
+                numerators.push_back(std::int64_t(value.getNumerator()) * (common / value.getDenominator()));
+            }
+            auto width = static_cast<unsigned>(std::bit_width(dictionary.size() - 1));
+            data.push_back(static_cast<unsigned char>(width));
+            pack(data, indices, width);
+            putDeltas(data, numerators);
+            return;
+        }
+
+        data.push_back(DENOMINATOR_RUNS_BLOCK);
+        for (std::size_t first = 0; first < values.size();)
+        {
+            int denominator = values[first].getDenominator();
+            std::size_t last = first + 1;
+            while (last < values.size() && values[last].getDenominator() == denominator)
+            {
+                ++last;
+            }
+            putVarint(data, dictionaryIndex[denominator]);
+            putVarint(data, last - first);
+            numerators.clear();
+            for (std::size_t index = first; index < last; ++index)
+            {
+                numerators.push_back(values[index].getNumerator());
+            }
+            putDeltas(data, numerators);
+            first = last;
+        }
+    }
+
+    std::size_t CompressedFractionColumn::decodeBlock(std::size_t block, std::span<Fraction> values) const
+    {
+        if (block >= blockOffsets.size())
+        {
+            throw std::out_of_range("Block index out of range");
+        }
+        std::size_t expected = blockValues(block);
+        if (values.size() < expected)
+        {
+            throw std::invalid_argument("Output must hold a whole block");
+        }
+        const unsigned char *position = data.data() + blockOffsets[block];
+        const unsigned char *last = data.data() + (block + 1 < blockOffsets.size() ? blockOffsets[block + 1] : data.size() - LOAD_PADDING);
+        std::size_t count = getVarint(position, last);
+        std::size_t dictionarySize = getVarint(position, last);
+        if (count != expected || dictionarySize > count || (count != 0 && dictionarySize == 0) || position == last)
+        {
+            corrupt();
+        }
+        std::vector<int> dictionary(dictionarySize);
+        for (int &denominator : dictionary)
+        {
+            std::uint64_t stored = getVarint(position, last);
+            if (stored == 0 || stored > std::numeric_limits<int>::max() || position == last)
+            {
+                corrupt();
+            }
+            denominator = static_cast<int>(stored);
+        }
+        unsigned char mode = *position++;
+        std::vector<std::uint64_t> scratch(count);
+        std::vector<std::int64_t> numerators(count);
+
+        if (mode == COMMON_DENOMINATOR_BLOCK)
+        {
+            std::int64_t common = commonDenominator(dictionary);
+            unsigned width = position != last ? *position++ : 0;
+            std::size_t packedBytes = (count * width + BYTE_BITS - 1) / BYTE_BITS;
+            if (common == 0 || width > MAX_PACKED_BITS || packedBytes > static_cast<std::size_t>(last - position))
+            {
+                corrupt();
+            }
+            std::vector<std::uint64_t> indices(count);
+            unpack(position, count, width, indices.data());
+            position += packedBytes;
+            getDeltas(position, last, count, numerators.data(), scratch.data());
+            std::vector<std::int64_t> scales(dictionarySize);
+            for (std::size_t entry = 0; entry < dictionarySize; ++entry)
+            {
+                scales[entry] = common / dictionary[entry];
+            }
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                std::uint64_t entry = indices[index];
+                if (entry >= dictionarySize || numerators[index] % scales[entry] != 0)
+                {
+                    corrupt();
+                }
+                values[index] = decodedFraction(numerators[index] / scales[entry], dictionary[entry]);
+            }
+            return count;
+        }
+        if (mode != DENOMINATOR_RUNS_BLOCK)
+        {
+            corrupt();
+        }
+        std::size_t written = 0;
+        while (written < count)
+        {
+            std::uint64_t entry = getVarint(position, last);
+            std::size_t length = getVarint(position, last);
+            if (entry >= dictionarySize || length == 0 || length > count - written)
+            {
+                corrupt();
+            }
+            getDeltas(position, last, length, numerators.data(), scratch.data());
+            int denominator = dictionary[entry];
+            for (std::size_t index = 0; index < length; ++index)
+            {
+                values[written++] = decodedFraction(numerators[index], denominator);
+            }
+        }
+        return count;
+    }
+
+    Fraction CompressedFractionColumn::at(std::size_t index) const
+    {
+        if (index >= valueCount)
+        {
+            throw std::out_of_range("Index out of range");
+        }
+        std::vector<Fraction> block(blockValues(index / valuesPerBlock));
+        decodeBlock(index / valuesPerBlock, block);
+        return block[index % valuesPerBlock];
+    }
+
+    std::vector<Fraction> CompressedFractionColumn::decode() const
+    {
+        std::vector<Fraction> values(valueCount);
+        std::span<Fraction> output(values);
+        for (std::size_t block = 0; block < blockOffsets.size(); ++block)
+        {
+            decodeBlock(block, output.subspan(block * valuesPerBlock));
+        }
+        return values;
+    }
+
+    std::size_t CompressedFractionColumn::blockValues(std::size_t block) const
+    {
+        return std::min(valuesPerBlock, valueCount - block * valuesPerBlock);
+    }
+
+    void CompressedFractionColumn::write(std::ostream &output) const
+    {
+        std::span<const unsigned char> blocks(data.data(), data.size() - LOAD_PADDING);
+        output.write(COLUMN_MAGIC.data(), COLUMN_MAGIC.size());
+        putUint64(output, COLUMN_VERSION);
+        putUint64(output, valueCount);
+        putUint64(output, valuesPerBlock);
+        putUint64(output, blockOffsets.size());
+        putUint64(output, blocks.size());
+        putUint64(output, crc32(blocks));
+        for (std::uint64_t offset : blockOffsets)
+        {
+            putUint64(output, offset);
+        }
+        output.write(reinterpret_cast<const char *>(blocks.data()), static_cast<std::streamsize>(blocks.size()));
+    }
+
+    CompressedFractionColumn CompressedFractionColumn::read(std::istream &input)
+    {
+        std::array<char, 4> magic{};
+        input.read(magic.data(), magic.size());
+        if (input.gcount() != static_cast<std::streamsize>(magic.size()) || magic != COLUMN_MAGIC)
+        {
+            throw std::runtime_error("Not a compressed fraction column");
+        }
+        if (getUint64(input) != COLUMN_VERSION)
+        {
+            throw std::runtime_error("Unsupported compressed fraction column version");
+        }
+        CompressedFractionColumn column;
+        column.valueCount = getUint64(input);
+        column.valuesPerBlock = getUint64(input);
+        std::uint64_t blocks = getUint64(input);
+        std::uint64_t bytes = getUint64(input);
+        std::uint64_t checksum = getUint64(input);
+        if (column.valuesPerBlock == 0 || column.valuesPerBlock > FRACTION_COMPRESS_MAX_BLOCK || blocks != column.valueCount / column.valuesPerBlock + (column.valueCount % column.valuesPerBlock != 0 ? 1 : 0) ||
+            bytes > std::uint64_t(1) << 40)
+        {
+            throw std::runtime_error("Corrupt compressed fraction column");
+        }
+        for (std::uint64_t block = 0; block < blocks; ++block)
+        {
+            column.blockOffsets.push_back(getUint64(input));
+            if (column.blockOffsets.back() > bytes || (block > 0 && column.blockOffsets.back() < column.blockOffsets[block - 1]))
+            {
+                throw std::runtime_error("Corrupt compressed fraction column");
+            }
+        }
+        column.data.resize(bytes + LOAD_PADDING);
+        input.read(reinterpret_cast<char *>(column.data.data()), static_cast<std::streamsize>(bytes));
+        if (input.gcount() != static_cast<std::streamsize>(bytes))
+        {
+            throw std::runtime_error("Truncated compressed fraction column");
+        }
+        if (crc32(std::span<const unsigned char>(column.data.data(), bytes)) != checksum)
+        {
+            throw std::runtime_error("Corrupt compressed fraction column");
+        }
+        return column;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "Fraction.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace ariel
+{
+    /// @brief most values per block of a CompressedFractionColumn, it bounds the decode buffers
+    const std::size_t FRACTION_COMPRESS_MAX_BLOCK = std::size_t(1) << 24;
+
+    /// @brief
+    /// Compressed, immutable column of fractions made for sorted data. The column is cut into blocks
+    /// that decode independently, each with a dictionary of its distinct denominators. When their lcm is
+    /// small, as for prices whose reduced denominators divide 100, the block is a single run over that
+    /// common denominator: bit-packed dictionary indices plus the scaled numerators. Otherwise the block is
+    /// split into runs of values sharing one denominator. Numerators of a run are stored as the first one
+    /// and the differences of neighbours relative to their minimum, bit-packed at a fixed width, so decoding
+    /// is a branch-free unpack loop followed by a prefix sum and sorted data costs a few bits per value.
+    class CompressedFractionColumn
+    {
+    private:
+        std::vector<unsigned char> data;
+        std::vector<std::uint64_t> blockOffsets;
+        std::size_t valueCount = 0;
+        std::size_t valuesPerBlock = 0;
+
+        CompressedFractionColumn() = default;
+        void encodeBlock(std::span<const Fraction> values);
+        /// values held by a block, blockSize() for all but the last one
+        std::size_t blockValues(std::size_t block) const;
+
+    public:
+        /// @brief compress a sequence of fractions
+        /// @param values the values in column order, sorted input compresses best
+        /// @param blockSize values per independently decodable block, throws invalid_argument if 0 or
+        /// above FRACTION_COMPRESS_MAX_BLOCK
+        explicit CompressedFractionColumn(std::span<const Fraction> values, std::size_t blockSize = 1024);
+
+        /// @brief number of values
+        std::size_t size() const
+        {
+            return valueCount;
+        }
+
+        /// @brief values per block, only the last block may be shorter
+        std::size_t blockSize() const
+        {
+            return valuesPerBlock;
+        }
+
+        /// @brief number of blocks
+        std::size_t blockCount() const
+        {
+            return blockOffsets.size();
+        }
+
+        /// @brief bytes taken by the encoded blocks and their index
+        std::size_t compressedBytes() const
+        {
+            return data.size() + blockOffsets.size() * sizeof(std::uint64_t);
+        }
+
+        /// @brief decode one block
+        /// @param block index of the block, throws out_of_range if it does not exist
+        /// @param values output, must hold the values of the block, blockSize() or fewer for the last block,
+        /// else throws invalid_argument
+        /// @return number of values decoded, runtime_error if the block does not hold as many as it should
+        std::size_t decodeBlock(std::size_t block, std::span<Fraction> values) const;
+
+        /// @brief decode a single value, costs the decoding of its block
+        /// @param index index of the value, throws out_of_range if it does not exist
+        Fraction at(std::size_t index) const;
+
+        /// @brief decode the whole column
+        std::vector<Fraction> decode() const;
+
+        /// @brief write the column to a binary stream, with a CRC-32 of the encoded blocks
+        void write(std::ostream &output) const;
+
+        /// @brief read a column written by write, throws runtime_error if the data is invalid
+        static CompressedFractionColumn read(std::istream &input);
+    };
+}
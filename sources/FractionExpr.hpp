@@ -0,0 +1,197 @@
+#pragma once
+#include "Fraction.hpp"
+#include "FractionWide.hpp"
+
+namespace ariel
+{
+    /// @brief
+    /// Base of the expression template layer. An expression such as lazy(a) + b - c * lazy(d) is captured
+    /// as a tree of small value nodes and evaluated in one pass over WideRational intermediates,
+    /// with a single reduction and a single overflow check when it is converted to a Fraction.
+    /// Unlike the Fraction operators, overflow is only reported if the reduced result does not fit.
+    /// Operator precedence still applies: in lazy(a) + b - c * d the product c * d binds first and is
+    /// two plain Fractions, so it is evaluated eagerly before joining the expression.
+    /// @tparam Derived the concrete expression node
+    template <typename Derived>
+    struct FractionExpr
+    {
+        /// @brief the concrete expression node
+        const Derived &self() const
+        {
+            return static_cast<const Derived &>(*this);
+        }
+
+        /// @brief evaluate the expression without reducing or narrowing it
+        /// @return WideRational the unreduced value of the expression
+        WideRational evaluateWide() const
+        {
+            return self().evaluate();
+        }
+
+        /// @brief evaluate the expression into a reduced Fraction
+        /// @return Fraction the value of the expression, throws overflow_error if it does not fit
+        Fraction eval() const
+        {
+            return self().evaluate().toFraction();
+        }
+
+        /// @brief implicit conversion so that assigning an expression to a Fraction evaluates it
+        operator Fraction() const
+        {
+            return eval();
+        }
+    };
+
+    /// @brief leaf of an expression, holds its Fraction by value so expressions never dangle
+    class FractionTerm : public FractionExpr<FractionTerm>
+    {
+    private:
+        Fraction value;
+
+    public:
+        /// @brief constructor for a leaf holding a copy of the Fraction
+        /// @param fraction Fraction object to capture
+        explicit FractionTerm(const Fraction &fraction) : value(fraction) {}
+
+        /// @brief widened value of the leaf
+        WideRational evaluate() const
+        {
+            return WideRational::of(value);
+        }
+    };
+
+    /// @brief inner node of an expression applying Operation to the values of its two children
+    template <typename Operation, typename Left, typename Right>
+    class FractionBinaryExpr : public FractionExpr<FractionBinaryExpr<Operation, Left, Right>>
+    {
+    private:
+        Left left;
+        Right right;
+
+    public:
+        /// @brief constructor for a node over two sub expressions
+        FractionBinaryExpr(const Left &leftExpr, const Right &rightExpr) : left(leftExpr), right(rightExpr) {}
+
+        /// @brief unreduced value of the node
+        WideRational evaluate() const
+        {
+            return Operation::apply(left.evaluate(), right.evaluate());
+        }
+    };
+
+    /// @brief addition node operation
+    struct FractionAddOp
+    {
+        static WideRational apply(const WideRational &left, const WideRational &right) { return WideRational::add(left, right); }
+    };
+
+    /// @brief subtraction node operation
+    struct FractionSubOp
+    {
+        static WideRational apply(const WideRational &left, const WideRational &right) { return WideRational::sub(left, right); }
+    };
+
+    /// @brief multiplication node operation
+    struct FractionMulOp
+    {
+        static WideRational apply(const WideRational &left, const WideRational &right) { return WideRational::mul(left, right); }
+    };
+
+    /// @brief division node operation, throws runtime_error when dividing by 0
+    struct FractionDivOp
+    {
+        static WideRational apply(const WideRational &left, const WideRational &right) { return WideRational::div(left, right); }
+    };
+
+    /// @brief start an expression from a Fraction, e.g. Fraction r = lazy(a) + b - c * lazy(d);
+    /// @param fraction Fraction object to capture
+    /// @return FractionTerm leaf that combines lazily with the other operands
+    inline FractionTerm lazy(const Fraction &fraction)
+    {
+        return FractionTerm(fraction);
+    }
+
+    /// @brief add two expressions lazily
+    template <typename Left, typename Right>
+    FractionBinaryExpr<FractionAddOp, Left, Right> operator+(const FractionExpr<Left> &left, const FractionExpr<Right> &right)
+    {
+        return FractionBinaryExpr<FractionAddOp, Left, Right>(left.self(), right.self());
+    }
+
+    /// @brief add an expression and a Fraction lazily
+    template <typename Left>
+    FractionBinaryExpr<FractionAddOp, Left, FractionTerm> operator+(const FractionExpr<Left> &left, const Fraction &right)
+    {
+        return FractionBinaryExpr<FractionAddOp, Left, FractionTerm>(left.self(), FractionTerm(right));
+    }
+
+    /// @brief add a Fraction and an expression lazily
+    template <typename Right>
+    FractionBinaryExpr<FractionAddOp, FractionTerm, Right> operator+(const Fraction &left, const FractionExpr<Right> &right)
+    {
+        return FractionBinaryExpr<FractionAddOp, FractionTerm, Right>(FractionTerm(left), right.self());
+    }
+
+    /// @brief subtract two expressions lazily
+    template <typename Left, typename Right>
+    FractionBinaryExpr<FractionSubOp, Left, Right> operator-(const FractionExpr<Left> &left, const FractionExpr<Right> &right)
+    {
+        return FractionBinaryExpr<FractionSubOp, Left, Right>(left.self(), right.self());
+    }
+
+    /// @brief subtract an expression and a Fraction lazily
+    template <typename Left>
+    FractionBinaryExpr<FractionSubOp, Left, FractionTerm> operator-(const FractionExpr<Left> &left, const Fraction &right)
+    {
+        return FractionBinaryExpr<FractionSubOp, Left, FractionTerm>(left.self(), FractionTerm(right));
+    }
+
+    /// @brief subtract a Fraction and an expression lazily
+    template <typename Right>
+    FractionBinaryExpr<FractionSubOp, FractionTerm, Right> operator-(const Fraction &left, const FractionExpr<Right> &right)
+    {
+        return FractionBinaryExpr<FractionSubOp, FractionTerm, Right>(FractionTerm(left), right.self());
+    }
+
+    /// @brief multiply two expressions lazily
+    template <typename Left, typename Right>
+    FractionBinaryExpr<FractionMulOp, Left, Right> operator*(const FractionExpr<Left> &left, const FractionExpr<Right> &right)
+    {
+        return FractionBinaryExpr<FractionMulOp, Left, Right>(left.self(), right.self());
+    }
+
+    /// @brief multiply an expression and a Fraction lazily
+    template <typename Left>
+    FractionBinaryExpr<FractionMulOp, Left, FractionTerm> operator*(const FractionExpr<Left> &left, const Fraction &right)
+    {
+        return FractionBinaryExpr<FractionMulOp, Left, FractionTerm>(left.self(), FractionTerm(right));
+    }
+
+    /// @brief multiply a Fraction and an expression lazily
+    template <typename Right>
+    FractionBinaryExpr<FractionMulOp, FractionTerm, Right> operator*(const Fraction &left, const FractionExpr<Right> &right)
+    {
+        return FractionBinaryExpr<FractionMulOp, FractionTerm, Right>(FractionTerm(left), right.self());
+    }
+
+    /// @brief divide two expressions lazily
+    template <typename Left, typename Right>
+    FractionBinaryExpr<FractionDivOp, Left, Right> operator/(const FractionExpr<Left> &left, const FractionExpr<Right> &right)
+    {
+        return FractionBinaryExpr<FractionDivOp, Left, Right>(left.self(), right.self());
+    }
+
+    /// @brief divide an expression and a Fraction lazily
+    template <typename Left>
+    FractionBinaryExpr<FractionDivOp, Left, FractionTerm> operator/(const FractionExpr<Left> &left, const Fraction &right)
+    {
+        return FractionBinaryExpr<FractionDivOp, Left, FractionTerm>(left.self(), FractionTerm(right));
+    }
+
+    /// @brief divide a Fraction and an expression lazily
+    template <typename Right>
+    FractionBinaryExpr<FractionDivOp, FractionTerm, Right> operator/(const Fraction &left, const FractionExpr<Right> &right)
+    {
+        return FractionBinaryExpr<FractionDivOp, FractionTerm, Right>(FractionTerm(left), right.self());
+    }
+}
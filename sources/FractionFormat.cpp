@@ -0,0 +1,178 @@
+#include "FractionFormat.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace ariel
+{
+    namespace
+    {
+        const long long DECIMAL_BASE = 10;
+
+        std::to_chars_result tooLarge(char *last)
+        {
+            return std::to_chars_result{last, std::errc::value_too_large};
+        }
+
+        /// "w r/d", or just the proper fraction when the whole part is 0
+        std::to_chars_result writeMixed(char *first, char *last, const Fraction &value)
+        {
+            long long numerator = value.getNumerator();
+            long long denominator = value.getDenominator();
+            long long whole = numerator / denominator;
+            if (whole == 0 || denominator == 1)
+            {
+                return denominator == 1 ? std::to_chars(first, last, numerator) : to_chars(first, last, value);
+            }
+            std::to_chars_result result = std::to_chars(first, last, whole);
+            if (result.ec != std::errc() || result.ptr == last)
+            {
+                return tooLarge(last);
+            }
+            *result.ptr = ' ';
+            result = std::to_chars(result.ptr + 1, last, std::llabs(numerator % denominator));
+            if (result.ec != std::errc() || result.ptr == last)
+            {
+                return tooLarge(last);
+            }
+            *result.ptr = '/';
+            return std::to_chars(result.ptr + 1, last, denominator);
+        }
+
+        /// fixed point by long division, the last digit rounded half away from zero
+        std::to_chars_result writeDecimal(char *first, char *last, const Fraction &value, unsigned precision)
+        {
+            long long magnitude = std::llabs((long long)value.getNumerator());
+            long long denominator = value.getDenominator();
+            long long whole = magnitude / denominator;
+            long long remainder = magnitude % denominator;
+            std::array<char, FRACTION_MAX_PRECISION> digits{};
+            for (unsigned digit = 0; digit < precision; ++digit)
+            {
+                remainder *= DECIMAL_BASE;
+                digits[digit] = static_cast<char>('0' + remainder / denominator);
+                remainder %= denominator;
+            }
+            if (remainder * 2 >= denominator)
+            {
+                unsigned digit = precision;
+                while (digit > 0 && digits[digit - 1] == '9')
+                {
+                    digits[--digit] = '0';
+                }
+                if (digit == 0)
+                {
+                    ++whole;
+                }
+                else
+                {
+                    ++digits[digit - 1];
+                }
+            }
+            bool zero = whole == 0 && std::all_of(digits.begin(), digits.begin() + precision, [](char digit)
+                                                  { return digit == '0'; });
+            char *position = first;
+            if (value.getNumerator() < 0 && !zero)
+            {
+                if (position == last)
+                {
+                    return tooLarge(last);
+                }
+                *position++ = '-';
+            }
+            std::to_chars_result result = std::to_chars(position, last, whole);
+            if (result.ec != std::errc() || precision == 0)
+            {
+                return result;
+            }
+            if ((std::size_t)(last - result.ptr) < precision + 1)
+            {
+                return tooLarge(last);
+            }
+            *result.ptr = '.';
+            return std::to_chars_result{std::copy(digits.begin(), digits.begin() + precision, result.ptr + 1), std::errc()};
+        }
+    }
+
+    std::to_chars_result to_chars(char *first, char *last, const Fraction &value)
+    {
+        std::to_chars_result result = std::to_chars(first, last, value.getNumerator());
+        if (result.ec != std::errc() || result.ptr == last)
+        {
+            return std::to_chars_result{last, std::errc::value_too_large};
+        }
+        *result.ptr = '/';
+        return std::to_chars(result.ptr + 1, last, value.getDenominator());
+    }
+
+    std::to_chars_result to_chars(char *first, char *last, const Fraction &value, const FractionFormatSpec &spec)
+    {
+        switch (spec.style)
+        {
+        case FractionStyle::mixed:
+            return writeMixed(first, last, value);
+        case FractionStyle::decimal:
+            return writeDecimal(first, last, value, std::min(spec.precision, FRACTION_MAX_PRECISION));
+        default:
+            return to_chars(first, last, value);
+        }
+    }
+
+    std::string format_fraction(const Fraction &value, std::string_view spec)
+    {
+        FractionFormatSpec parsed;
+        if (!parse_format_spec(spec, parsed))
+        {
+            throw std::invalid_argument("Invalid format specification");
+        }
+        std::array<char, FRACTION_FORMAT_CHARS_MAX> buffer{};
+        std::to_chars_result result = to_chars(buffer.data(), buffer.data() + buffer.size(), value, parsed);
+        return std::string(buffer.data(), result.ptr);
+    }
+
+    FractionWriter::FractionWriter(std::ostream &outputStream, std::size_t bufferSize)
+        : output(outputStream), buffer(std::max(bufferSize, FRACTION_CHARS_MAX + 1))
+    {
+    }
+
+    FractionWriter::~FractionWriter()
+    {
+        flush();
+    }
+
+    void FractionWriter::write(const Fraction &value, char separator)
+    {
+        if (buffer.size() - used < FRACTION_CHARS_MAX + 1)
+        {
+            flush();
+        }
+        char *position = buffer.data() + used;
+        position = to_chars(position, buffer.data() + buffer.size(), value).ptr;
+        *position++ = separator;
+        used = (std::size_t)(position - buffer.data());
+    }
+
+    void FractionWriter::write(std::span<const Fraction> values, char separator)
+    {
+        for (const Fraction &value : values)
+        {
+            write(value, separator);
+        }
+    }
+
+    void FractionWriter::flush()
+    {
+        if (used != 0)
+        {
+            output.write(buffer.data(), (std::streamsize)used);
+            used = 0;
+        }
+    }
+
+    void write_fractions(std::ostream &outputStream, std::span<const Fraction> values)
+    {
+        FractionWriter writer(outputStream);
+        writer.write(values);
+    }
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include "Fraction.hpp"
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <version>
+#ifdef __cpp_lib_format
+#include <algorithm>
+#include <array>
+#include <format>
+#endif
+
+namespace ariel
+{
+    /// @brief longest text written by to_chars, "-2147483648/2147483647"
+    const std::size_t FRACTION_CHARS_MAX = 22;
+
+    /// @brief
+    /// Write "n/d" into [first, last) with no allocation and no locale, the same text as operator<<.
+    /// @param first start of the output buffer
+    /// @param last end of the output buffer
+    /// @param value Fraction object to write
+    /// @return to_chars_result with the end of the written text, or {last, errc::value_too_large}
+    /// if the buffer is too small, in which case its contents are unspecified
+    std::to_chars_result to_chars(char *first, char *last, const Fraction &value);
+
+    /// @brief most fractional digits of the decimal presentation
+    const unsigned FRACTION_MAX_PRECISION = 32;
+
+    /// @brief longest text written by to_chars with a FractionFormatSpec
+    const std::size_t FRACTION_FORMAT_CHARS_MAX = 12 + FRACTION_MAX_PRECISION;
+
+    /// @brief presentation of a Fraction
+    enum class FractionStyle
+    {
+        /// "n/d" like operator<<, format type 'r' or none
+        ratio,
+        /// "-1 1/2", a proper fraction alone if the whole part is 0, format type 'm'
+        mixed,
+        /// fixed point decimal rounded half away from zero, format type 'f'
+        decimal
+    };
+
+    /// @brief parsed format specification
+    struct FractionFormatSpec
+    {
+        FractionStyle style = FractionStyle::ratio;
+        /// @brief fractional digits of the decimal presentation
+        unsigned precision = 3;
+    };
+
+    /// @brief
+    /// Parse a format specification "[.precision][type]" where type is 'r' (n/d, the default),
+    /// 'm' (mixed number) or 'f' (decimal, 3 digits unless a precision is given). The precision
+    /// is only allowed with 'f' and at most FRACTION_MAX_PRECISION.
+    /// @param text the specification without braces and colon, e.g. ".5f"
+    /// @param spec receives the parsed specification
+    /// @return false if the specification is invalid
+    constexpr bool parse_format_spec(std::string_view text, FractionFormatSpec &spec)
+    {
+        spec = FractionFormatSpec{};
+        std::size_t position = 0;
+        bool hasPrecision = false;
+        if (position < text.size() && text[position] == '.')
+        {
+            std::size_t digitsStart = ++position;
+            unsigned precision = 0;
+            while (position < text.size() && text[position] >= '0' && text[position] <= '9')
+            {
+                precision = precision * 10 + static_cast<unsigned>(text[position] - '0');
+                if (precision > FRACTION_MAX_PRECISION)
+                {
+                    return false;
+                }
+                ++position;
+            }
+            if (position == digitsStart)
+            {
+                return false;
+            }
+            spec.precision = precision;
+            hasPrecision = true;
+        }
+        if (position < text.size())
+        {
+            switch (text[position])
+            {
+            case 'r':
+                spec.style = FractionStyle::ratio;
+                break;
+            case 'm':
+                spec.style = FractionStyle::mixed;
+                break;
+            case 'f':
+                spec.style = FractionStyle::decimal;
+                break;
+            default:
+                return false;
+            }
+            ++position;
+        }
+        return position == text.size() && (!hasPrecision || spec.style == FractionStyle::decimal);
+    }
+
+    /// @brief
+    /// Write a Fraction in the given presentation into [first, last) in a single pass. Decimal digits
+    /// come from integer long division, so they are exact up to the rounding of the last digit.
+    /// @param first start of the output buffer, FRACTION_FORMAT_CHARS_MAX bytes always suffice
+    /// @param last end of the output buffer
+    /// @param value Fraction object to write
+    /// @param spec presentation to use
+    /// @return to_chars_result with the end of the written text, or {last, errc::value_too_large}
+    std::to_chars_result to_chars(char *first, char *last, const Fraction &value, const FractionFormatSpec &spec);
+
+    /// @brief
+    /// Format a Fraction into a string with a specification understood by parse_format_spec,
+    /// for toolchains without <format>, e.g. format_fraction(value, ".2f") == "0.33".
+    /// @param value Fraction object to format
+    /// @param spec format specification, throws invalid_argument if it is invalid
+    /// @return std::string the formatted value
+    std::string format_fraction(const Fraction &value, std::string_view spec = "");
+
+    /// @brief
+    /// Buffered writer for columns of fractions. Records are formatted with to_chars into one
+    /// buffer that is handed to the stream with a single write when it fills up, instead of
+    /// three formatted insertions per value. The buffer is flushed on destruction.
+    class FractionWriter
+    {
+    private:
+        std::ostream &output;
+        std::vector<char> buffer;
+        std::size_t used = 0;
+
+    public:
+        /// @brief constructor for a writer over a stream
+        /// @param outputStream stream that receives the text
+        /// @param bufferSize bytes buffered between writes to the stream, at least FRACTION_CHARS_MAX + 1
+        explicit FractionWriter(std::ostream &outputStream, std::size_t bufferSize = std::size_t(1) << 16);
+
+        FractionWriter(const FractionWriter &) = delete;
+        FractionWriter &operator=(const FractionWriter &) = delete;
+
+        /// @brief destructor for FractionWriter, flushes the buffered text
+        ~FractionWriter();
+
+        /// @brief append one value followed by the separator
+        /// @param value Fraction object to write
+        /// @param separator character written after the value
+        void write(const Fraction &value, char separator = '\n');
+
+        /// @brief append every value, each followed by the separator
+        /// @param values Fraction objects to write
+        /// @param separator character written after each value
+        void write(std::span<const Fraction> values, char separator = '\n');
+
+        /// @brief hand the buffered text to the stream
+        void flush();
+    };
+
+    /// @brief write a column of fractions through a FractionWriter, one value per line
+    /// @param outputStream stream that receives the text
+    /// @param values Fraction objects to write
+    void write_fractions(std::ostream &outputStream, std::span<const Fraction> values);
+}
+
+#ifdef __cpp_lib_format
+/// @brief std::format support for Fraction, e.g. std::format("{:m} {:.2f}", value, value), see parse_format_spec
+template <>
+struct std::formatter<ariel::Fraction>
+{
+    ariel::FractionFormatSpec spec;
+
+    constexpr std::format_parse_context::iterator parse(std::format_parse_context &context)
+    {
+        auto end = std::find(context.begin(), context.end(), '}');
+        if (!ariel::parse_format_spec(std::string_view(context.begin(), end), spec))
+        {
+            throw std::format_error("invalid format specification for Fraction");
+        }
+        return end;
+    }
+
+    template <typename FormatContext>
+    typename FormatContext::iterator format(const ariel::Fraction &value, FormatContext &context) const
+    {
+        std::array<char, ariel::FRACTION_FORMAT_CHARS_MAX> buffer{};
+        std::to_chars_result result = ariel::to_chars(buffer.data(), buffer.data() + buffer.size(), value, spec);
+        return std::copy(buffer.data(), result.ptr, context.out());
+    }
+};
+#endif
@@ -0,0 +1,26 @@
+#include "FractionKernels.hpp"
+#include "FractionWide.hpp"
+#include <stdexcept>
+
+namespace ariel
+{
+    Fraction fma(const Fraction &left, const Fraction &right, const Fraction &addend)
+    {
+        WideRational product = WideRational::mul(WideRational::of(left), WideRational::of(right));
+        return WideRational::add(product, WideRational::of(addend)).toFraction();
+    }
+
+    Fraction dot(std::span<const Fraction> left, std::span<const Fraction> right)
+    {
+        if (left.size() != right.size())
+        {
+            throw std::invalid_argument("Vectors must have the same size");
+        }
+        WideRational sum;
+        for (std::size_t i = 0; i < left.size(); ++i)
+        {
+            sum.accumulate(WideRational::mul(WideRational::of(left[i]), WideRational::of(right[i])));
+        }
+        return sum.toFraction();
+    }
+}
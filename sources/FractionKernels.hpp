@@ -0,0 +1,19 @@
+#pragma once
+#include "Fraction.hpp"
+#include <span>
+
+namespace ariel
+{
+    /// @brief exact fused multiply-add, computes left * right + addend with a single reduction
+    /// @param left Fraction object to multiply
+    /// @param right Fraction object to multiply
+    /// @param addend Fraction object to add to the product
+    /// @return the reduced result, throws overflow_error only if the reduced result does not fit
+    Fraction fma(const Fraction &left, const Fraction &right, const Fraction &addend);
+
+    /// @brief exact dot product, accumulates in wide intermediates and reduces only at the end
+    /// @param left first vector of Fraction objects
+    /// @param right second vector of Fraction objects, must have the same size as left else throws invalid_argument
+    /// @return the reduced sum of the pairwise products, throws overflow_error only if the reduced result does not fit
+    Fraction dot(std::span<const Fraction> left, std::span<const Fraction> right);
+}
@@ -0,0 +1,128 @@
+#include "FractionLoader.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace ariel
+{
+    namespace
+    {
+        /// below this size the text is parsed on the calling thread
+        const std::size_t PARALLEL_THRESHOLD = 1 << 20;
+
+        /// rough lower bound of the bytes per record, used to reserve the output of a chunk
+        const std::size_t BYTES_PER_RECORD_ESTIMATE = 8;
+
+        /// output of one chunk, line numbers in errors are relative to the start of the chunk
+        struct ChunkResult
+        {
+            std::vector<Fraction> values;
+            std::vector<FractionLoadError> errors;
+            std::size_t lines = 0;
+        };
+
+        unsigned workerCount(unsigned threads, std::size_t size)
+        {
+            if (threads == 0)
+            {
+                threads = std::max(1U, std::thread::hardware_concurrency());
+            }
+            if (size < PARALLEL_THRESHOLD)
+            {
+                return 1;
+            }
+            return threads;
+        }
+
+        /// parse the lines of text[first, last), first is the start of a line
+        void parseChunk(std::string_view text, std::size_t first, std::size_t last, ChunkResult &result)
+        {
+            result.values.reserve((last - first) / BYTES_PER_RECORD_ESTIMATE);
+            const char *begin = text.data();
+            const char *position = begin + first;
+            const char *end = begin + last;
+            while (position != end)
+            {
+                const char *lineEnd = static_cast<const char *>(std::memchr(position, '\n', (std::size_t)(end - position)));
+                if (lineEnd == nullptr)
+                {
+                    lineEnd = end;
+                }
+                Fraction value;
+                FractionParseResult parsed = parse_fraction_line(position, lineEnd, value);
+                if (parsed.error != FractionParseError::none)
+                {
+                    result.errors.push_back(FractionLoadError{(std::size_t)(position - begin) + parsed.consumed, result.lines + 1, parsed.error});
+                }
+                else if (parsed.consumed != 0)
+                {
+                    result.values.push_back(value);
+                }
+                ++result.lines;
+                position = lineEnd == end ? end : lineEnd + 1;
+            }
+        }
+    }
+
+    FractionLoadResult parse_fraction_lines(std::string_view text, unsigned threads)
+    {
+        unsigned workers = workerCount(threads, text.size());
+        std::vector<std::size_t> bounds{0};
+        for (unsigned chunk = 1; chunk < workers; ++chunk)
+        {
+            // move every split point past the next newline so that no line is cut in two
+            std::size_t split = std::max(text.size() * chunk / workers, bounds.back());
+            std::size_t newline = text.find('\n', split);
+            bounds.push_back(newline == std::string_view::npos ? text.size() : newline + 1);
+        }
+        bounds.push_back(text.size());
+
+        std::vector<ChunkResult> chunks(bounds.size() - 1);
+        if (chunks.size() == 1)
+        {
+            parseChunk(text, 0, text.size(), chunks[0]);
+        }
+        else
+        {
+            std::vector<std::thread> pool;
+            for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk)
+            {
+                pool.emplace_back([&text, &bounds, &chunks, chunk]()
+                                  { parseChunk(text, bounds[chunk], bounds[chunk + 1], chunks[chunk]); });
+            }
+            for (std::thread &worker : pool)
+            {
+                worker.join();
+            }
+        }
+
+        FractionLoadResult result;
+        std::size_t valueCount = 0;
+        for (const ChunkResult &chunk : chunks)
+        {
+            valueCount += chunk.values.size();
+        }
+        result.values.reserve(valueCount);
+        std::size_t linesBefore = 0;
+        for (ChunkResult &chunk : chunks)
+        {
+            result.values.insert(result.values.end(), chunk.values.begin(), chunk.values.end());
+            for (FractionLoadError &error : chunk.errors)
+            {
+                error.line += linesBefore;
+                result.errors.push_back(error);
+            }
+            linesBefore += chunk.lines;
+            chunk.values = std::vector<Fraction>();
+        }
+        result.lines = linesBefore;
+        return result;
+    }
+
+    FractionLoadResult load_fractions(const std::string &path, unsigned threads)
+    {
+        MappedFile file(path, MappedFile::Access::sequential);
+        return parse_fraction_lines(file.text(), threads);
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Fraction.hpp"
+#include "FractionParse.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ariel
+{
+    /// @brief a line that could not be parsed by the loader
+    struct FractionLoadError
+    {
+        /// @brief byte offset of the offending character from the start of the input
+        std::size_t offset;
+        /// @brief 1 based line number
+        std::size_t line;
+        /// @brief why the line was rejected
+        FractionParseError error;
+    };
+
+    /// @brief the values of the lines that parsed, in input order, and the lines that did not
+    struct FractionLoadResult
+    {
+        std::vector<Fraction> values;
+        std::vector<FractionLoadError> errors;
+        /// @brief number of lines in the input, blank ones included
+        std::size_t lines = 0;
+    };
+
+    /// @brief
+    /// Parse one fraction per line in any form accepted by parse_fraction. Blank lines are skipped,
+    /// trailing blanks and '\r' are allowed, anything else after the value rejects the line.
+    /// The text is split into chunks at line boundaries that are parsed in parallel, a line with
+    /// an error is reported and left out of the values without throwing.
+    /// @param text the input, one record per line
+    /// @param threads number of worker threads, 0 uses the hardware concurrency
+    /// @return FractionLoadResult the parsed column and the per line errors
+    FractionLoadResult parse_fraction_lines(std::string_view text, unsigned threads = 0);
+
+    /// @brief
+    /// Memory map a file and parse it with parse_fraction_lines. This replaces a loop over operator>>
+    /// for bulk ingestion, the file is never copied into a stream buffer.
+    /// @param path file to load, throws runtime_error if it cannot be opened or mapped
+    /// @param threads number of worker threads, 0 uses the hardware concurrency
+    /// @return FractionLoadResult the parsed column and the per line errors
+    FractionLoadResult load_fractions(const std::string &path, unsigned threads = 0);
+}
@@ -0,0 +1,223 @@
+#include "FractionParse.hpp"
+#include "FractionWide.hpp"
+#include <charconv>
+#include <cstdint>
+#include <limits>
+
+namespace ariel
+{
+    namespace
+    {
+        const unsigned MAX_DECIMAL_DIGITS = 18;
+        const std::int64_t DECIMAL_BASE = 10;
+
+        bool isBlank(char character)
+        {
+            return character == ' ' || character == '\t';
+        }
+
+        bool isLineBlank(char character)
+        {
+            return isBlank(character) || character == '\r';
+        }
+
+        bool isDigit(char character)
+        {
+            return character >= '0' && character <= '9';
+        }
+
+        const char *skipBlanks(const char *position, const char *last)
+        {
+            while (position != last && isBlank(*position))
+            {
+                ++position;
+            }
+            return position;
+        }
+
+        /// optional sign followed by digits, the magnitude is limited to 64 bits
+        FractionParseError parseInteger(const char *&position, const char *last, bool &negative, std::uint64_t &magnitude)
+        {
+            const char *cursor = position;
+            negative = false;
+            if (cursor != last && (*cursor == '-' || *cursor == '+'))
+            {
+                negative = *cursor == '-';
+                ++cursor;
+            }
+            if (cursor == last || !isDigit(*cursor))
+            {
+                return FractionParseError::invalidInput;
+            }
+            auto [end, error] = std::from_chars(cursor, last, magnitude);
+            if (error == std::errc::result_out_of_range)
+            {
+                return FractionParseError::overflow;
+            }
+            position = end;
+            return FractionParseError::none;
+        }
+
+        wide_int signedValue(bool negative, std::uint64_t magnitude)
+        {
+            return negative ? -(wide_int)magnitude : (wide_int)magnitude;
+        }
+
+        /// reduce numerator / denominator and store it if it fits in a Fraction, reducing only once
+        FractionParseError store(WideRational rational, Fraction &value)
+        {
+            if (rational.denominator == 0)
+            {
+                return FractionParseError::zeroDenominator;
+            }
+            if (rational.denominator < 0)
+            {
+                rational.numerator = -rational.numerator;
+                rational.denominator = -rational.denominator;
+            }
+            if (rational.denominator <= std::numeric_limits<int>::max() && rational.numerator <= std::numeric_limits<int>::max() &&
+                rational.numerator >= std::numeric_limits<int>::min())
+            {
+                value = Fraction((int)rational.numerator, (int)rational.denominator);
+                return FractionParseError::none;
+            }
+            rational.reduce();
+            if (rational.numerator > std::numeric_limits<int>::max() || rational.numerator < std::numeric_limits<int>::min() ||
+                rational.denominator > std::numeric_limits<int>::max())
+            {
+                return FractionParseError::overflow;
+            }
+            value = rational.toFraction();
+            return FractionParseError::none;
+        }
+
+        FractionParseResult failure(FractionParseError error)
+        {
+            return FractionParseResult{0, error};
+        }
+    }
+
+    FractionParseResult parse_fraction(const char *first, const char *last, Fraction &value)
+    {
+        const char *position = skipBlanks(first, last);
+        bool negative = false;
+        std::uint64_t whole = 0;
+        FractionParseError error = parseInteger(position, last, negative, whole);
+        if (error != FractionParseError::none)
+        {
+            return failure(error);
+        }
+
+        WideRational result{signedValue(negative, whole), 1};
+        if (position != last && *position == '/')
+        {
+            const char *cursor = position + 1;
+            bool denominatorNegative = false;
+            std::uint64_t denominator = 0;
+            error = parseInteger(cursor, last, denominatorNegative, denominator);
+            if (error != FractionParseError::none)
+            {
+                return failure(error);
+            }
+            result.denominator = signedValue(denominatorNegative, denominator);
+            position = cursor;
+        }
+        else if (position != last && *position == '.' && position + 1 != last && isDigit(position[1]))
+        {
+            const char *cursor = position + 1;
+            std::int64_t scale = 1;
+            std::int64_t digits = 0;
+            for (unsigned count = 0; cursor != last && isDigit(*cursor); ++cursor, ++count)
+            {
+                if (count == MAX_DECIMAL_DIGITS)
+                {
+                    return failure(FractionParseError::overflow);
+                }
+                digits = digits * DECIMAL_BASE + (*cursor - '0');
+                scale *= DECIMAL_BASE;
+            }
+            result.numerator = signedValue(negative, whole) * scale + (negative ? -digits : digits);
+            result.denominator = scale;
+            position = cursor;
+        }
+        else if (position != last && isBlank(*position))
+        {
+            const char *cursor = skipBlanks(position, last);
+            bool secondNegative = false;
+            std::uint64_t second = 0;
+            if (parseInteger(cursor, last, secondNegative, second) == FractionParseError::none)
+            {
+                bool thirdNegative = false;
+                std::uint64_t third = 0;
+                if (cursor != last && *cursor == '/')
+                {
+                    ++cursor;
+                    error = parseInteger(cursor, last, thirdNegative, third);
+                    if (error != FractionParseError::none || secondNegative || thirdNegative)
+                    {
+                        return failure(error == FractionParseError::none ? FractionParseError::invalidInput : error);
+                    }
+                    // mixed number: the whole part carries the sign of the value
+                    wide_int scaled = 0;
+                    if (WideRational::mulOverflow(signedValue(negative, whole), (wide_int)third, &scaled))
+                    {
+                        return failure(FractionParseError::overflow);
+                    }
+                    result.numerator = scaled + signedValue(negative, second);
+                    result.denominator = third;
+                }
+                else
+                {
+                    result.denominator = signedValue(secondNegative, second);
+                }
+                position = cursor;
+            }
+        }
+
+        error = store(result, value);
+        if (error != FractionParseError::none)
+        {
+            return failure(error);
+        }
+        return FractionParseResult{(std::size_t)(position - first), FractionParseError::none};
+    }
+
+    FractionParseResult parse_fraction(std::string_view text, Fraction &value)
+    {
+        return parse_fraction(text.data(), text.data() + text.size(), value);
+    }
+
+    FractionParseResult parse_fraction_line(const char *first, const char *last, Fraction &value)
+    {
+        if ((std::size_t)(last - first) > FRACTION_LINE_MAX)
+        {
+            return FractionParseResult{FRACTION_LINE_MAX, FractionParseError::lineTooLong};
+        }
+        const char *cursor = first;
+        while (cursor != last && isLineBlank(*cursor))
+        {
+            ++cursor;
+        }
+        if (cursor == last)
+        {
+            return FractionParseResult{0, FractionParseError::none};
+        }
+        Fraction parsed;
+        FractionParseResult result = parse_fraction(first, last, parsed);
+        if (result.error != FractionParseError::none)
+        {
+            return result;
+        }
+        cursor = first + result.consumed;
+        while (cursor != last && isLineBlank(*cursor))
+        {
+            ++cursor;
+        }
+        if (cursor != last)
+        {
+            return FractionParseResult{(std::size_t)(cursor - first), FractionParseError::invalidInput};
+        }
+        value = parsed;
+        return FractionParseResult{(std::size_t)(last - first), FractionParseError::none};
+    }
+}
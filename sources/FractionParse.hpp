@@ -0,0 +1,57 @@
+#pragma once
+#include "Fraction.hpp"
+#include <cstddef>
+#include <string_view>
+
+namespace ariel
+{
+    /// @brief why parse_fraction did not produce a value
+    enum class FractionParseError
+    {
+        none,
+        invalidInput,
+        zeroDenominator,
+        overflow,
+        /// the line is longer than FRACTION_LINE_MAX, only reported by parse_fraction_line
+        lineTooLong
+    };
+
+    /// @brief
+    /// Longest line accepted by parse_fraction_line, several times the longest value text. It bounds the
+    /// memory a streaming reader spends on a line that continues across chunks.
+    const std::size_t FRACTION_LINE_MAX = 256;
+
+    /// @brief outcome of parse_fraction
+    struct FractionParseResult
+    {
+        /// @brief bytes read from the start of the input including leading blanks, 0 on error
+        std::size_t consumed;
+        /// @brief FractionParseError::none on success
+        FractionParseError error;
+    };
+
+    /// @brief
+    /// Locale-free, non-throwing fraction parser built on std::from_chars. After optional leading spaces
+    /// and tabs it accepts "n/d", "n d" (the operator>> format), integers "n", exact decimals "n.ddd" and
+    /// mixed numbers "w n/d". Parsing stops at the first character that does not continue the value,
+    /// so records can be parsed in place out of a large buffer.
+    /// @param first start of the text
+    /// @param last end of the text
+    /// @param value receives the reduced value, unchanged on error
+    /// @return bytes consumed and the error code
+    FractionParseResult parse_fraction(const char *first, const char *last, Fraction &value);
+
+    /// @brief parse_fraction over a string_view, see the pointer overload
+    FractionParseResult parse_fraction(std::string_view text, Fraction &value);
+
+    /// @brief
+    /// Parse one line of a fraction file: a single value in any parse_fraction form, optionally
+    /// surrounded by blanks and ended by '\r'. The line must not contain its '\n'.
+    /// @param first start of the line
+    /// @param last end of the line
+    /// @param value receives the value, unchanged for a blank line or on error
+    /// @return error none with consumed == 0 for a blank line, error none with the line length for a value,
+    /// or the error with consumed set to the offset of the offending character within the line.
+    /// A line longer than FRACTION_LINE_MAX is rejected with lineTooLong at offset FRACTION_LINE_MAX
+    FractionParseResult parse_fraction_line(const char *first, const char *last, Fraction &value);
+}
@@ -0,0 +1,436 @@
+#include "FractionPipeline.hpp"
+#include "ConcurrentQueue.hpp"
+#include "FractionFormat.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace ariel
+{
+    namespace
+    {
+        /// unit of work flowing through the stages, text is the input of the parse stage
+        /// and reused as the output of the format stage
+        struct Batch
+        {
+            std::uint64_t sequence = 0;
+            /// marks the end of the input, one per thread of the next stage
+            bool end = false;
+            /// byte offset of the batch in the input
+            std::size_t offset = 0;
+            std::string text;
+            std::vector<Fraction> values;
+            /// offsets and line numbers relative to the batch
+            std::vector<FractionLoadError> errors;
+            std::size_t lines = 0;
+        };
+
+        using BatchQueue = ConcurrentQueue<Batch>;
+        using Clock = std::chrono::steady_clock;
+
+        /// retries of a blocked stage before it parks, enough to ride out a short gap between batches
+        const unsigned WAIT_SPINS = 64;
+
+        std::uint64_t elapsed(Clock::time_point since)
+        {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count());
+        }
+
+        struct StageCounters
+        {
+            std::atomic<std::uint64_t> batches{0};
+            std::atomic<std::uint64_t> items{0};
+            std::atomic<std::uint64_t> busy{0};
+            std::atomic<std::uint64_t> wait{0};
+
+            void record(std::uint64_t count, Clock::time_point since)
+            {
+                batches.fetch_add(1, std::memory_order_relaxed);
+                items.fetch_add(count, std::memory_order_relaxed);
+                busy.fetch_add(elapsed(since), std::memory_order_relaxed);
+            }
+
+            FractionStageStats stats(const char *name, unsigned threads) const
+            {
+                return FractionStageStats{name, threads, batches.load(), items.load(), busy.load(), wait.load()};
+            }
+        };
+
+        /// state shared by the threads of one run
+        class RunState
+        {
+        private:
+            std::mutex failureMutex;
+            std::exception_ptr failure;
+
+        public:
+            std::atomic<bool> failed{false};
+            /// batches written so far, the reader stays at most inFlight batches ahead
+            std::atomic<std::uint64_t> written{0};
+            /// bumped on every push, pop, written batch and failure, the word parked stages wait on
+            std::atomic<std::uint32_t> progress{0};
+
+            /// wake the parked stages so they retry, cheap while none is parked
+            void signal()
+            {
+                progress.fetch_add(1, std::memory_order_release);
+                progress.notify_all();
+            }
+
+            /// record the exception being handled, the first one wins, and stop every stage
+            void fail()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure)
+                    {
+                        failure = std::current_exception();
+                    }
+                }
+                failed.store(true, std::memory_order_release);
+                signal();
+            }
+
+            void rethrow()
+            {
+                if (failure)
+                {
+                    std::rethrow_exception(failure);
+                }
+            }
+
+            /// wait until the operation succeeds, false if the run failed meanwhile. A blocked stage retries
+            /// a few times and then parks until another stage makes progress, so idle threads leave the
+            /// cores to the slowest stage
+            template <typename Operation>
+            bool waitFor(Operation operation, StageCounters &counters)
+            {
+                if (operation())
+                {
+                    return true;
+                }
+                Clock::time_point start = Clock::now();
+                bool done = false;
+                for (unsigned spin = 0; spin < WAIT_SPINS && !failed.load(std::memory_order_acquire); ++spin)
+                {
+                    if ((done = operation()))
+                    {
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+                while (!done && !failed.load(std::memory_order_acquire))
+                {
+                    // read the word before retrying, a signal after the read makes the wait return at once
+                    std::uint32_t seen = progress.load(std::memory_order_acquire);
+                    if ((done = operation()) || failed.load(std::memory_order_acquire))
+                    {
+                        break;
+                    }
+                    progress.wait(seen, std::memory_order_acquire);
+                }
+                counters.wait.fetch_add(elapsed(start), std::memory_order_relaxed);
+                return done;
+            }
+
+            bool push(BatchQueue &queue, Batch &batch, StageCounters &counters)
+            {
+                bool pushed = waitFor([&queue, &batch]()
+                                      { return queue.tryPush(batch); },
+                                      counters);
+                if (pushed)
+                {
+                    signal();
+                }
+                return pushed;
+            }
+
+            bool pop(BatchQueue &queue, Batch &batch, StageCounters &counters)
+            {
+                bool popped = waitFor([&queue, &batch]()
+                                      { return queue.tryPop(batch); },
+                                      counters);
+                if (popped)
+                {
+                    signal();
+                }
+                return popped;
+            }
+        };
+
+        /// loop of one worker of a middle stage, the last worker to stop passes one end marker per downstream thread
+        template <typename Work>
+        void workerLoop(RunState &run, BatchQueue &input, BatchQueue &output, StageCounters &counters, std::atomic<unsigned> &active,
+                        unsigned downstream, Work work)
+        {
+            try
+            {
+                Batch batch;
+                while (run.pop(input, batch, counters) && !batch.end)
+                {
+                    Clock::time_point start = Clock::now();
+                    std::size_t items = work(batch);
+                    counters.record(items, start);
+                    if (!run.push(output, batch, counters))
+                    {
+                        break;
+                    }
+                }
+            }
+            catch (...)
+            {
+                run.fail();
+            }
+            if (active.fetch_sub(1) == 1)
+            {
+                for (unsigned index = 0; index < downstream; ++index)
+                {
+                    Batch marker;
+                    marker.end = true;
+                    run.push(output, marker, counters);
+                }
+            }
+        }
+
+        void readLoop(RunState &run, std::istream &input, std::size_t chunkBytes, std::uint64_t inFlight, BatchQueue &output,
+                      StageCounters &counters, unsigned downstream)
+        {
+            try
+            {
+                std::string carry;
+                std::uint64_t sequence = 0;
+                std::size_t offset = 0;
+                /// dropping the rest of a line longer than FRACTION_LINE_MAX up to its newline
+                bool skipping = false;
+                bool last = false;
+                while (!last)
+                {
+                    if (!run.waitFor([&run, sequence, inFlight]()
+                                     { return sequence < run.written.load(std::memory_order_acquire) + inFlight; },
+                                     counters))
+                    {
+                        return;
+                    }
+                    Clock::time_point start = Clock::now();
+                    Batch batch;
+                    batch.text = std::move(carry);
+                    carry = std::string();
+                    std::size_t kept = batch.text.size();
+                    batch.text.resize(kept + chunkBytes);
+                    input.read(batch.text.data() + kept, static_cast<std::streamsize>(chunkBytes));
+                    if (input.bad())
+                    {
+                        // a short read is the end of the input only if the stream did not fail
+                        throw std::runtime_error("Cannot read fraction stream");
+                    }
+                    auto count = static_cast<std::size_t>(input.gcount());
+                    batch.text.resize(kept + count);
+                    last = count < chunkBytes;
+                    if (skipping)
+                    {
+                        std::size_t newline = batch.text.find('\n');
+                        std::size_t skipped = newline == std::string::npos ? batch.text.size() : newline + 1;
+                        batch.text.erase(0, skipped);
+                        offset += skipped;
+                        skipping = newline == std::string::npos;
+                    }
+                    std::size_t dropped = 0;
+                    if (!last)
+                    {
+                        // keep the partial last line for the next batch
+                        std::size_t newline = batch.text.rfind('\n');
+                        if (newline == std::string::npos && batch.text.size() <= FRACTION_LINE_MAX)
+                        {
+                            carry = std::move(batch.text);
+                            continue;
+                        }
+                        if (newline == std::string::npos)
+                        {
+                            // a line too long to carry goes alone in a batch, cut just past FRACTION_LINE_MAX
+                            // so that parsing rejects it, and its rest is skipped as it is read
+                            dropped = batch.text.size() - (FRACTION_LINE_MAX + 1);
+                            batch.text.resize(FRACTION_LINE_MAX + 1);
+                            skipping = true;
+                        }
+                        else
+                        {
+                            carry.assign(batch.text, newline + 1);
+                            batch.text.resize(newline + 1);
+                        }
+                    }
+                    batch.sequence = sequence++;
+                    batch.offset = offset;
+                    offset += batch.text.size() + dropped;
+                    counters.record(batch.text.size(), start);
+                    if (!run.push(output, batch, counters))
+                    {
+                        return;
+                    }
+                }
+            }
+            catch (...)
+            {
+                run.fail();
+                return;
+            }
+            for (unsigned index = 0; index < downstream; ++index)
+            {
+                Batch marker;
+                marker.end = true;
+                run.push(output, marker, counters);
+            }
+        }
+
+        std::size_t parseBatch(Batch &batch)
+        {
+            FractionLoadResult parsed = parse_fraction_lines(batch.text, 1);
+            batch.values = std::move(parsed.values);
+            batch.errors = std::move(parsed.errors);
+            batch.lines = parsed.lines;
+            return batch.values.size();
+        }
+
+        std::size_t formatBatch(Batch &batch)
+        {
+            batch.text.resize(batch.values.size() * (FRACTION_CHARS_MAX + 1));
+            char *position = batch.text.data();
+            char *end = position + batch.text.size();
+            for (const Fraction &value : batch.values)
+            {
+                position = to_chars(position, end, value).ptr;
+                *position++ = '\n';
+            }
+            batch.text.resize(static_cast<std::size_t>(position - batch.text.data()));
+            std::size_t count = batch.values.size();
+            batch.values = std::vector<Fraction>();
+            return count;
+        }
+    }
+
+    FractionPipeline::FractionPipeline(FractionPipelineConfig pipelineConfig) : config(pipelineConfig)
+    {
+        config.chunkBytes = std::max<std::size_t>(config.chunkBytes, 1);
+        config.parseThreads = std::max(config.parseThreads, 1U);
+        config.computeThreads = std::max(config.computeThreads, 1U);
+        config.formatThreads = std::max(config.formatThreads, 1U);
+        config.queueCapacity = std::max<std::size_t>(config.queueCapacity, 2);
+    }
+
+    FractionPipeline &FractionPipeline::addKernel(FractionBatchTransform kernel)
+    {
+        kernels.push_back(std::move(kernel));
+        return *this;
+    }
+
+    FractionPipelineStats FractionPipeline::run(std::istream &input, std::ostream &output) const
+    {
+        RunState run;
+        BatchQueue parseQueue(config.queueCapacity);
+        BatchQueue computeQueue(config.queueCapacity);
+        BatchQueue formatQueue(config.queueCapacity);
+        BatchQueue writeQueue(config.queueCapacity);
+        std::array<StageCounters, 5> counters;
+        std::atomic<unsigned> parseActive{config.parseThreads};
+        std::atomic<unsigned> computeActive{config.computeThreads};
+        std::atomic<unsigned> formatActive{config.formatThreads};
+        // enough batches to fill every queue and keep every worker busy, so the reorder buffer stays bounded
+        std::uint64_t inFlight = 4 * parseQueue.capacity() + config.parseThreads + config.computeThreads + config.formatThreads;
+
+        std::vector<std::thread> threads;
+        threads.emplace_back([&]()
+                             { readLoop(run, input, config.chunkBytes, inFlight, parseQueue, counters[0], config.parseThreads); });
+        for (unsigned index = 0; index < config.parseThreads; ++index)
+        {
+            threads.emplace_back([&]()
+                                 { workerLoop(run, parseQueue, computeQueue, counters[1], parseActive, config.computeThreads, parseBatch); });
+        }
+        for (unsigned index = 0; index < config.computeThreads; ++index)
+        {
+            threads.emplace_back([&]()
+                                 { workerLoop(run, computeQueue, formatQueue, counters[2], computeActive, config.formatThreads,
+                                              [this](Batch &batch)
+                                              {
+                                                  std::size_t count = batch.values.size();
+                                                  for (const FractionBatchTransform &kernel : kernels)
+                                                  {
+                                                      count = std::min(count, kernel(std::span<Fraction>(batch.values.data(), count)));
+                                                  }
+                                                  batch.values.resize(count);
+                                                  return count;
+                                              }); });
+        }
+        for (unsigned index = 0; index < config.formatThreads; ++index)
+        {
+            threads.emplace_back([&]()
+                                 { workerLoop(run, formatQueue, writeQueue, counters[3], formatActive, 1, formatBatch); });
+        }
+
+        FractionPipelineStats stats;
+        try
+        {
+            // batches arrive in any order, they are written by sequence number
+            std::map<std::uint64_t, Batch> pending;
+            std::uint64_t next = 0;
+            std::size_t linesBefore = 0;
+            Batch batch;
+            while (run.pop(writeQueue, batch, counters[4]) && !batch.end)
+            {
+                std::uint64_t sequence = batch.sequence;
+                pending.emplace(sequence, std::move(batch));
+                for (auto ready = pending.begin(); ready != pending.end() && ready->first == next; ready = pending.erase(ready), ++next)
+                {
+                    Clock::time_point start = Clock::now();
+                    Batch &current = ready->second;
+                    output.write(current.text.data(), static_cast<std::streamsize>(current.text.size()));
+                    if (!output)
+                    {
+                        throw std::runtime_error("Cannot write fraction stream");
+                    }
+                    for (FractionLoadError error : current.errors)
+                    {
+                        if (stats.errors.size() < FRACTION_STREAM_MAX_ERRORS)
+                        {
+                            error.offset += current.offset;
+                            error.line += linesBefore;
+                            stats.errors.push_back(error);
+                        }
+                    }
+                    stats.errorCount += current.errors.size();
+                    linesBefore += current.lines;
+                    counters[4].record(current.text.size(), start);
+                    run.written.store(next + 1, std::memory_order_release);
+                    run.signal();
+                }
+            }
+            output.flush();
+        }
+        catch (...)
+        {
+            run.fail();
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        run.rethrow();
+
+        const std::array<const char *, 5> names{"read", "parse", "compute", "format", "write"};
+        const std::array<unsigned, 5> stageThreads{1, config.parseThreads, config.computeThreads, config.formatThreads, 1};
+        for (std::size_t stage = 0; stage < names.size(); ++stage)
+        {
+            stats.stages.push_back(counters[stage].stats(names[stage], stageThreads[stage]));
+        }
+        stats.valuesRead = stats.stages[1].items;
+        stats.valuesWritten = stats.stages[3].items;
+        return stats;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "Fraction.hpp"
+#include "FractionLoader.hpp"
+#include "FractionStream.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ariel
+{
+    /// @brief threads and buffering of a FractionPipeline
+    struct FractionPipelineConfig
+    {
+        /// @brief bytes of text per batch, a batch always ends on a line boundary
+        std::size_t chunkBytes = std::size_t(1) << 18;
+        unsigned parseThreads = 1;
+        unsigned computeThreads = 1;
+        unsigned formatThreads = 1;
+        /// @brief batches in flight between two stages, rounded up to a power of two
+        std::size_t queueCapacity = 8;
+    };
+
+    /// @brief throughput counters of one pipeline stage, summed over its threads
+    struct FractionStageStats
+    {
+        std::string name;
+        unsigned threads = 0;
+        std::uint64_t batches = 0;
+        /// @brief values leaving the stage, bytes for the read and write stages
+        std::uint64_t items = 0;
+        /// @brief time spent working on batches
+        std::uint64_t busyNanoseconds = 0;
+        /// @brief time spent waiting for input from the previous stage or for room in the next one
+        std::uint64_t waitNanoseconds = 0;
+    };
+
+    /// @brief counters of a FractionPipeline run
+    struct FractionPipelineStats
+    {
+        /// @brief read, parse, compute, format and write, in pipeline order
+        std::vector<FractionStageStats> stages;
+        std::size_t valuesRead = 0;
+        std::size_t valuesWritten = 0;
+        std::size_t errorCount = 0;
+        /// @brief the first FRACTION_STREAM_MAX_ERRORS rejected lines, in input order
+        std::vector<FractionLoadError> errors;
+    };
+
+    /// @brief
+    /// Staged version of process_fraction_stream. A reader thread cuts the input into batches of whole
+    /// lines, parse workers turn them into values with parse_fraction_line, compute workers run the
+    /// kernels, format workers write the results with to_chars and the calling thread writes them to
+    /// the output in input order. Stages are connected by bounded lock-free queues, so memory stays
+    /// bounded and a slow stage shows up as wait time in the stages around it.
+    class FractionPipeline
+    {
+    private:
+        FractionPipelineConfig config;
+        std::vector<FractionBatchTransform> kernels;
+
+    public:
+        /// @brief constructor for a pipeline with no kernels, it copies its input in canonical "n/d" form
+        explicit FractionPipeline(FractionPipelineConfig pipelineConfig = {});
+
+        /// @brief append a kernel to the compute stage, kernels run in the order they were added.
+        /// A kernel may be called from several compute threads at once
+        /// @return FractionPipeline& this pipeline
+        FractionPipeline &addKernel(FractionBatchTransform kernel);
+
+        /// @brief stream input through the stages to output
+        /// @param input text stream with one fraction per line
+        /// @param output text stream that receives the results
+        /// @return FractionPipelineStats the per stage counters, an exception thrown by a kernel or
+        /// by a stream is rethrown once every stage has stopped, a read that sets badbit throws runtime_error
+        FractionPipelineStats run(std::istream &input, std::ostream &output) const;
+    };
+}
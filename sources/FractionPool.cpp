@@ -0,0 +1,208 @@
+#include "FractionPool.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace ariel
+{
+    namespace
+    {
+        const unsigned SEGMENT_BITS = 12;
+        const std::size_t SEGMENT_SIZE = std::size_t(1) << SEGMENT_BITS;
+        const std::uint64_t MIX_MULTIPLIER_1 = 0xFF51AFD7ED558CCDULL;
+        const std::uint64_t MIX_MULTIPLIER_2 = 0xC4CEB9FE1A85EC53ULL;
+        const unsigned MIX_SHIFT = 33;
+        const unsigned SHARD_BITS = 32;
+        const std::size_t DECIMAL_DIGITS = 3;
+        const long long DECIMAL_SCALE = 1000;
+
+        /// reduced fractions have a positive denominator so a packed key is never 0, the empty slot marker
+        std::uint64_t packKey(const Fraction &fraction)
+        {
+            return (std::uint64_t(std::uint32_t(fraction.getNumerator())) << 32) | std::uint32_t(fraction.getDenominator());
+        }
+
+        /// MurmurHash3 fmix64 finalizer, every bit of the key affects every bit of the hash, so values
+        /// sharing a denominator still spread over all shards and slots
+        std::uint64_t mixKey(std::uint64_t key)
+        {
+            key ^= key >> MIX_SHIFT;
+            key *= MIX_MULTIPLIER_1;
+            key ^= key >> MIX_SHIFT;
+            key *= MIX_MULTIPLIER_2;
+            return key ^ (key >> MIX_SHIFT);
+        }
+
+        /// shard from the high bits of the hash (multiply-shift range reduction, any shard count),
+        /// leaving the low bits to the slot probe
+        std::size_t shardIndex(std::uint64_t hash, std::size_t shardCount)
+        {
+            return static_cast<std::size_t>(((hash >> SHARD_BITS) * shardCount) >> SHARD_BITS);
+        }
+
+        /// rounds half away from zero with integer arithmetic, so the text does not depend on the locale
+        std::string toDecimal(const Fraction &fraction)
+        {
+            long long numerator = fraction.getNumerator();
+            long long denominator = fraction.getDenominator();
+            bool negative = numerator < 0;
+            long long scaled = (std::llabs(numerator) * DECIMAL_SCALE * 2 + denominator) / (denominator * 2);
+            std::string digits = std::to_string(scaled % DECIMAL_SCALE);
+            std::string result = (negative && scaled != 0) ? "-" : "";
+            result += std::to_string(scaled / DECIMAL_SCALE) + "." + std::string(DECIMAL_DIGITS - digits.size(), '0') + digits;
+            return result;
+        }
+    }
+
+    FractionPool::FractionPool(std::size_t capacityVal, unsigned shardCount)
+        : capacity(capacityVal), shards(shardCount == 0 ? 1 : shardCount)
+    {
+        if (capacity == 0 || capacity > std::size_t(std::numeric_limits<std::uint32_t>::max()))
+        {
+            throw std::invalid_argument("Invalid pool capacity");
+        }
+        std::size_t slotsPerShard = std::bit_ceil(2 * capacity / shards.size() + 1);
+        slotMask = slotsPerShard - 1;
+        for (Shard &shard : shards)
+        {
+            shard.slots = std::make_unique<Slot[]>(slotsPerShard);
+        }
+        segmentCount = (capacity + SEGMENT_SIZE - 1) / SEGMENT_SIZE;
+        segments = std::make_unique<std::atomic<Entry *>[]>(segmentCount);
+        for (std::size_t segment = 0; segment < segmentCount; ++segment)
+        {
+            segments[segment].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    FractionPool::~FractionPool()
+    {
+        for (std::size_t segment = 0; segment < segmentCount; ++segment)
+        {
+            delete[] segments[segment].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::uint32_t FractionPool::intern(const Fraction &fraction)
+    {
+        std::optional<std::uint32_t> existing = find(fraction);
+        if (existing)
+        {
+            return *existing;
+        }
+        std::uint64_t key = packKey(fraction);
+        std::uint64_t hash = mixKey(key);
+        Shard &shard = shards[shardIndex(hash, shards.size())];
+        std::lock_guard<std::mutex> lock(shard.insertMutex);
+        for (std::size_t probe = 0; probe <= slotMask; ++probe)
+        {
+            Slot &slot = shard.slots[(hash + probe) & slotMask];
+            std::uint64_t slotKey = slot.key.load(std::memory_order_relaxed);
+            if (slotKey == key)
+            {
+                return slot.identifier.load(std::memory_order_relaxed);
+            }
+            if (slotKey == 0)
+            {
+                std::uint32_t identifier = count.fetch_add(1, std::memory_order_relaxed);
+                if (identifier >= capacity)
+                {
+                    count.fetch_sub(1, std::memory_order_relaxed);
+                    throw std::length_error("Fraction pool is full");
+                }
+                Entry &created = createEntry(identifier);
+                created.value = fraction;
+                created.real = (double)fraction.getNumerator() / fraction.getDenominator();
+                created.decimal = toDecimal(fraction);
+                slot.identifier.store(identifier, std::memory_order_relaxed);
+                slot.key.store(key, std::memory_order_release);
+                return identifier;
+            }
+        }
+        throw std::length_error("Fraction pool shard is full");
+    }
+
+    void FractionPool::intern(std::span<const Fraction> values, std::span<std::uint32_t> ids)
+    {
+        if (values.size() != ids.size())
+        {
+            throw std::invalid_argument("Values and ids must have the same size");
+        }
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            ids[i] = intern(values[i]);
+        }
+    }
+
+    std::optional<std::uint32_t> FractionPool::find(const Fraction &fraction) const
+    {
+        std::uint64_t key = packKey(fraction);
+        std::uint64_t hash = mixKey(key);
+        const Shard &shard = shards[shardIndex(hash, shards.size())];
+        for (std::size_t probe = 0; probe <= slotMask; ++probe)
+        {
+            const Slot &slot = shard.slots[(hash + probe) & slotMask];
+            std::uint64_t slotKey = slot.key.load(std::memory_order_acquire);
+            if (slotKey == key)
+            {
+                return slot.identifier.load(std::memory_order_relaxed);
+            }
+            if (slotKey == 0)
+            {
+                return std::nullopt;
+            }
+        }
+        return std::nullopt;
+    }
+
+    const Fraction &FractionPool::value(std::uint32_t identifier) const
+    {
+        return entry(identifier).value;
+    }
+
+    double FractionPool::toDouble(std::uint32_t identifier) const
+    {
+        return entry(identifier).real;
+    }
+
+    const std::string &FractionPool::decimal(std::uint32_t identifier) const
+    {
+        return entry(identifier).decimal;
+    }
+
+    std::size_t FractionPool::size() const
+    {
+        return std::min<std::size_t>(count.load(std::memory_order_acquire), capacity);
+    }
+
+    const FractionPool::Entry &FractionPool::entry(std::uint32_t identifier) const
+    {
+        Entry *segment = identifier < size() ? segments[identifier >> SEGMENT_BITS].load(std::memory_order_acquire) : nullptr;
+        if (segment == nullptr)
+        {
+            throw std::out_of_range("Unknown fraction id");
+        }
+        return segment[identifier & (SEGMENT_SIZE - 1)];
+    }
+
+    FractionPool::Entry &FractionPool::createEntry(std::uint32_t identifier)
+    {
+        std::atomic<Entry *> &segment = segments[identifier >> SEGMENT_BITS];
+        Entry *entries = segment.load(std::memory_order_acquire);
+        if (entries == nullptr)
+        {
+            auto *allocated = new Entry[SEGMENT_SIZE];
+            if (segment.compare_exchange_strong(entries, allocated, std::memory_order_acq_rel))
+            {
+                entries = allocated;
+            }
+            else
+            {
+                delete[] allocated;
+            }
+        }
+        return entries[identifier & (SEGMENT_SIZE - 1)];
+    }
+}
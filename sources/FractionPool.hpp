@@ -0,0 +1,91 @@
+#pragma once
+#include "Fraction.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ariel
+{
+    /// @brief
+    /// Flyweight pool mapping each distinct reduced Fraction to a dense 32-bit id, so columns can store
+    /// 4 byte ids, equality becomes id comparison and derived data is computed once per distinct value.
+    /// Lookups (find, value, toDouble, decimal) are lock-free, insertion locks one shard of the hash table.
+    /// An id obtained on another thread must be handed over with the usual synchronization (join, queue).
+    class FractionPool
+    {
+    public:
+        /// @brief cached data of one distinct value
+        struct Entry
+        {
+            Fraction value;
+            double real = 0;
+            std::string decimal;
+        };
+
+        /// @brief constructor for a pool holding up to capacity distinct values
+        /// @param capacity maximal number of distinct values, intern throws length_error beyond it
+        /// @param shards number of independently locked parts of the hash table
+        explicit FractionPool(std::size_t capacity = std::size_t(1) << 20, unsigned shards = 16);
+
+        ~FractionPool();
+        FractionPool(const FractionPool &) = delete;
+        FractionPool &operator=(const FractionPool &) = delete;
+        FractionPool(FractionPool &&) = delete;
+        FractionPool &operator=(FractionPool &&) = delete;
+
+        /// @brief id of the value, adding it to the pool if it is not there yet
+        /// @param fraction Fraction object to intern
+        /// @return the id of the value, throws length_error if the pool is full
+        std::uint32_t intern(const Fraction &fraction);
+
+        /// @brief intern a whole column of values
+        /// @param values Fraction objects to intern
+        /// @param ids output, must have the same size as values else throws invalid_argument
+        void intern(std::span<const Fraction> values, std::span<std::uint32_t> ids);
+
+        /// @brief lock-free lookup of a value that may not be in the pool
+        /// @return the id of the value or nothing if it was never interned
+        std::optional<std::uint32_t> find(const Fraction &fraction) const;
+
+        /// @brief the value with the given id, throws out_of_range for an unknown id
+        const Fraction &value(std::uint32_t identifier) const;
+
+        /// @brief the value with the given id as a double
+        double toDouble(std::uint32_t identifier) const;
+
+        /// @brief the value with the given id in decimal notation with 3 digits after the point
+        const std::string &decimal(std::uint32_t identifier) const;
+
+        /// @brief number of distinct values in the pool
+        std::size_t size() const;
+
+    private:
+        struct Slot
+        {
+            std::atomic<std::uint64_t> key{0};
+            std::atomic<std::uint32_t> identifier{0};
+        };
+
+        struct Shard
+        {
+            std::mutex insertMutex;
+            std::unique_ptr<Slot[]> slots;
+        };
+
+        std::size_t capacity;
+        std::size_t slotMask;
+        std::vector<Shard> shards;
+        std::unique_ptr<std::atomic<Entry *>[]> segments;
+        std::size_t segmentCount;
+        std::atomic<std::uint32_t> count{0};
+
+        const Entry &entry(std::uint32_t identifier) const;
+        Entry &createEntry(std::uint32_t identifier);
+    };
+}
@@ -0,0 +1,254 @@
+#include "FractionSort.hpp"
+#include "FractionTables.hpp"
+#include "FractionWide.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ariel
+{
+    namespace
+    {
+        /// below this size sorting is done on the calling thread
+        const std::size_t PARALLEL_THRESHOLD = 1 << 16;
+
+        /// bits sorted per radix pass, 2^11 counters per pass stay in the L1 cache
+        const unsigned RADIX_BITS = 11;
+        const std::size_t RADIX_BUCKETS = std::size_t(1) << RADIX_BITS;
+        const unsigned RADIX_PASSES = (64 + RADIX_BITS - 1) / RADIX_BITS;
+
+        template <typename Key>
+        struct KeyedIndex
+        {
+            Key key;
+            std::size_t index;
+        };
+
+        using SortKey = KeyedIndex<double>;
+        using RadixKey = KeyedIndex<std::uint64_t>;
+
+        unsigned workerCount(unsigned threads, std::size_t size)
+        {
+            if (threads == 0)
+            {
+                threads = std::max(1U, std::thread::hardware_concurrency());
+            }
+            if (size < PARALLEL_THRESHOLD)
+            {
+                return 1;
+            }
+            return threads;
+        }
+
+        /// sort equal sized chunks on separate threads, then merge neighbouring chunks pairwise
+        /// in parallel rounds through a scratch buffer
+        template <typename T, typename Compare>
+        void parallelSort(std::vector<T> &items, unsigned threads, Compare compare)
+        {
+            std::size_t size = items.size();
+            if (threads <= 1)
+            {
+                std::sort(items.begin(), items.end(), compare);
+                return;
+            }
+            std::vector<std::size_t> bounds;
+            for (unsigned chunk = 0; chunk <= threads; ++chunk)
+            {
+                bounds.push_back(size * chunk / threads);
+            }
+            std::vector<std::thread> workers;
+            for (std::size_t chunk = 0; chunk + 1 < bounds.size(); ++chunk)
+            {
+                workers.emplace_back([&items, &bounds, chunk, compare]()
+                                     { std::sort(items.begin() + (std::ptrdiff_t)bounds[chunk], items.begin() + (std::ptrdiff_t)bounds[chunk + 1], compare); });
+            }
+            for (std::thread &worker : workers)
+            {
+                worker.join();
+            }
+            std::vector<T> scratch(size);
+            while (bounds.size() > 2)
+            {
+                std::vector<std::size_t> merged;
+                workers.clear();
+                for (std::size_t chunk = 0; chunk + 1 < bounds.size(); chunk += 2)
+                {
+                    merged.push_back(bounds[chunk]);
+                    if (chunk + 2 >= bounds.size())
+                    {
+                        std::copy(items.begin() + (std::ptrdiff_t)bounds[chunk], items.begin() + (std::ptrdiff_t)bounds[chunk + 1],
+                                  scratch.begin() + (std::ptrdiff_t)bounds[chunk]);
+                        continue;
+                    }
+                    workers.emplace_back([&items, &scratch, &bounds, chunk, compare]()
+                                         {
+                        auto first = items.begin() + (std::ptrdiff_t)bounds[chunk];
+                        auto middle = items.begin() + (std::ptrdiff_t)bounds[chunk + 1];
+                        auto last = items.begin() + (std::ptrdiff_t)bounds[chunk + 2];
+                        std::merge(first, middle, middle, last, scratch.begin() + (std::ptrdiff_t)bounds[chunk], compare); });
+                }
+                merged.push_back(size);
+                for (std::thread &worker : workers)
+                {
+                    worker.join();
+                }
+                items.swap(scratch);
+                bounds.swap(merged);
+            }
+        }
+
+        /// sort every run of equal keys by the exact value of the Fraction objects they index
+        template <typename Key>
+        void fixUpTies(std::span<Fraction> values, std::vector<KeyedIndex<Key>> &keys)
+        {
+            ExactLess exactLess;
+            for (std::size_t first = 0; first < keys.size();)
+            {
+                std::size_t last = first + 1;
+                while (last < keys.size() && keys[last].key == keys[first].key)
+                {
+                    ++last;
+                }
+                if (last - first > 1)
+                {
+                    std::sort(keys.begin() + (std::ptrdiff_t)first, keys.begin() + (std::ptrdiff_t)last,
+                              [&values, &exactLess](const KeyedIndex<Key> &left, const KeyedIndex<Key> &right)
+                              { return exactLess(values[left.index], values[right.index]); });
+                }
+                first = last;
+            }
+        }
+
+        /// stable LSD radix sort on the 64-bit keys, passes whose digit is the same for every key are skipped
+        void radixSort(std::vector<RadixKey> &keys)
+        {
+            std::vector<std::array<std::size_t, RADIX_BUCKETS>> counts(RADIX_PASSES);
+            for (const RadixKey &item : keys)
+            {
+                for (unsigned pass = 0; pass < RADIX_PASSES; ++pass)
+                {
+                    ++counts[pass][(item.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+                }
+            }
+            std::vector<RadixKey> scratch(keys.size());
+            for (unsigned pass = 0; pass < RADIX_PASSES; ++pass)
+            {
+                std::array<std::size_t, RADIX_BUCKETS> &count = counts[pass];
+                if (std::find(count.begin(), count.end(), keys.size()) != count.end())
+                {
+                    continue;
+                }
+                std::size_t offset = 0;
+                for (std::size_t &bucket : count)
+                {
+                    std::size_t bucketSize = bucket;
+                    bucket = offset;
+                    offset += bucketSize;
+                }
+                for (const RadixKey &item : keys)
+                {
+                    scratch[count[(item.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++] = item;
+                }
+                keys.swap(scratch);
+            }
+        }
+
+        /// copy the values in the order given by the sorted keys back into the span
+        template <typename Key>
+        void applyOrder(std::span<Fraction> values, const std::vector<KeyedIndex<Key>> &keys)
+        {
+            std::vector<Fraction> original(values.begin(), values.end());
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                values[i] = original[keys[i].index];
+            }
+        }
+    }
+
+    int compareExact(const Fraction &left, const Fraction &right)
+    {
+        if (DefaultSmallTables::inRange(left.getNumerator(), left.getDenominator()) &&
+            DefaultSmallTables::inRange(right.getNumerator(), right.getDenominator()))
+        {
+            return DefaultSmallTables::compare(left.getNumerator(), left.getDenominator(), right.getNumerator(), right.getDenominator());
+        }
+        long long leftSide = (long long)left.getNumerator() * right.getDenominator();
+        long long rightSide = (long long)right.getNumerator() * left.getDenominator();
+        return (leftSide > rightSide) - (leftSide < rightSide);
+    }
+
+    void sort_fractions(std::span<Fraction> values, unsigned threads)
+    {
+        std::vector<SortKey> keys(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            keys[i] = SortKey{(double)values[i].getNumerator() / values[i].getDenominator(), i};
+        }
+        parallelSort(keys, workerCount(threads, keys.size()), [](const SortKey &left, const SortKey &right)
+                     { return left.key < right.key; });
+
+        fixUpTies(values, keys);
+        applyOrder(values, keys);
+    }
+
+    void radix_sort_fractions(std::span<Fraction> values, const RadixKeyRange &range)
+    {
+        if (range.maxDenominator <= 0 || compareExact(range.low, range.high) > 0)
+        {
+            throw std::invalid_argument("Invalid radix key range");
+        }
+        WideRational low = WideRational::of(range.low);
+        WideRational span = WideRational::sub(WideRational::of(range.high), low);
+        wide_int exactResolution = (wide_int)range.maxDenominator * range.maxDenominator;
+        wide_int resolution = exactResolution;
+        if (span.numerator != 0)
+        {
+            resolution = std::min(resolution, (wide_int)std::numeric_limits<std::uint64_t>::max() * span.denominator / span.numerator);
+        }
+        bool exact = resolution >= exactResolution;
+
+        std::vector<RadixKey> keys(values.size());
+        wide_int lowNumerator = range.low.getNumerator();
+        wide_int lowDenominator = range.low.getDenominator();
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            int denominator = values[i].getDenominator();
+            wide_int offsetNumerator = values[i].getNumerator() * lowDenominator - lowNumerator * denominator;
+            wide_int offsetDenominator = denominator * lowDenominator;
+            if (offsetNumerator < 0 || offsetNumerator * span.denominator > span.numerator * offsetDenominator)
+            {
+                throw std::out_of_range("Fraction outside of the radix key range");
+            }
+            exact = exact && denominator <= range.maxDenominator;
+            wide_int scaled = offsetNumerator * resolution;
+            std::uint64_t key = 0;
+            if (scaled <= std::numeric_limits<std::uint64_t>::max())
+            {
+                key = static_cast<std::uint64_t>(scaled) / static_cast<std::uint64_t>(offsetDenominator);
+            }
+            else
+            {
+                key = static_cast<std::uint64_t>(scaled / offsetDenominator);
+            }
+            keys[i] = RadixKey{key, i};
+        }
+        radixSort(keys);
+        if (!exact)
+        {
+            fixUpTies(values, keys);
+        }
+        applyOrder(values, keys);
+    }
+
+    void parallel_merge_sort_fractions(std::span<Fraction> values, unsigned threads)
+    {
+        std::vector<Fraction> items(values.begin(), values.end());
+        parallelSort(items, workerCount(threads, items.size()), ExactLess());
+        std::copy(items.begin(), items.end(), values.begin());
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "Fraction.hpp"
+#include <span>
+
+namespace ariel
+{
+    /// @brief exact three way comparison of two Fraction objects by cross multiplication
+    /// @return negative if left < right, 0 if they are equal, positive if left > right
+    int compareExact(const Fraction &left, const Fraction &right);
+
+    /// @brief exact strict weak ordering of Fraction objects, unlike operator< it does not round to 3 digits
+    struct ExactLess
+    {
+        bool operator()(const Fraction &left, const Fraction &right) const
+        {
+            return compareExact(left, right) < 0;
+        }
+    };
+
+    /// @brief
+    /// Sort Fraction objects in exact ascending order. The values are first sorted in parallel on a
+    /// precomputed double key, then runs of equal keys are fixed up with exact cross multiplication.
+    /// Correctly rounded division is monotonic, so only equal keys can be out of exact order.
+    /// @param values the Fraction objects to sort in place
+    /// @param threads number of worker threads, 0 uses the hardware concurrency
+    void sort_fractions(std::span<Fraction> values, unsigned threads = 0);
+
+    /// @brief value range and denominator bound of the data given to radix_sort_fractions
+    struct RadixKeyRange
+    {
+        /// @brief smallest value that may occur
+        Fraction low;
+        /// @brief largest value that may occur
+        Fraction high;
+        /// @brief largest denominator that is expected, larger ones are still sorted exactly but slower
+        int maxDenominator;
+    };
+
+    /// @brief
+    /// Sort Fraction objects in exact ascending order with an LSD radix sort on order preserving
+    /// 64-bit keys floor((value - low) * resolution). When the resolution is at least maxDenominator^2
+    /// distinct values get distinct keys and the result is exact without any comparison, otherwise
+    /// runs of equal keys are fixed up with exact cross multiplication.
+    /// @param values the Fraction objects to sort in place
+    /// @param range the range of the values, throws out_of_range if a value lies outside of it
+    void radix_sort_fractions(std::span<Fraction> values, const RadixKeyRange &range);
+
+    /// @brief sort Fraction objects in exact ascending order with a parallel merge sort on ExactLess
+    /// @param values the Fraction objects to sort in place
+    /// @param threads number of worker threads, 0 uses the hardware concurrency
+    void parallel_merge_sort_fractions(std::span<Fraction> values, unsigned threads = 0);
+}
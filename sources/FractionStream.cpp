@@ -0,0 +1,382 @@
+#include "FractionStream.hpp"
+#include "FractionFormat.hpp"
+#include "FractionParse.hpp"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace ariel
+{
+    namespace
+    {
+        /// a fixed size I/O buffer, last marks the final chunk of the stream
+        struct Chunk
+        {
+            std::vector<char> bytes;
+            std::size_t size = 0;
+            bool last = false;
+        };
+
+        /// two chunks handed back and forth between a producer and a consumer thread in order,
+        /// each side blocks while the other one holds both chunks
+        class ChunkExchange
+        {
+        private:
+            std::array<Chunk, 2> chunks;
+            std::array<bool, 2> full{};
+            std::size_t produceIndex = 0;
+            std::size_t consumeIndex = 0;
+            bool cancelled = false;
+            std::mutex mutex;
+            std::condition_variable changed;
+
+        public:
+            explicit ChunkExchange(std::size_t chunkBytes)
+            {
+                for (Chunk &chunk : chunks)
+                {
+                    chunk.bytes.resize(std::max<std::size_t>(chunkBytes, 1));
+                }
+            }
+
+            /// next empty chunk to fill, nullptr once cancelled
+            Chunk *beginProduce()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this]()
+                             { return !full[produceIndex] || cancelled; });
+                return cancelled ? nullptr : &chunks[produceIndex];
+            }
+
+            void endProduce()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    full[produceIndex] = true;
+                    produceIndex ^= 1U;
+                }
+                changed.notify_all();
+            }
+
+            /// next filled chunk in production order, nullptr once cancelled
+            Chunk *beginConsume()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this]()
+                             { return full[consumeIndex] || cancelled; });
+                return cancelled ? nullptr : &chunks[consumeIndex];
+            }
+
+            void endConsume()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    full[consumeIndex] = false;
+                    consumeIndex ^= 1U;
+                }
+                changed.notify_all();
+            }
+
+            void cancel()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    cancelled = true;
+                }
+                changed.notify_all();
+            }
+        };
+    }
+
+    struct FractionStreamReader::State
+    {
+        ChunkExchange exchange;
+        std::exception_ptr failure;
+        Chunk *current = nullptr;
+        std::size_t cursor = 0;
+        /// start of a line that continues in the next chunk, at most one byte past FRACTION_LINE_MAX
+        std::string pending;
+        std::size_t pendingOffset = 0;
+        std::size_t chunkOffset = 0;
+        std::size_t lines = 0;
+        std::size_t errorCount = 0;
+        std::vector<FractionLoadError> errors;
+        bool finished = false;
+        std::thread io;
+
+        State(std::istream &input, std::size_t chunkBytes) : exchange(chunkBytes)
+        {
+            io = std::thread([this, &input]()
+                             { readLoop(input); });
+        }
+
+        void readLoop(std::istream &input)
+        {
+            while (Chunk *chunk = exchange.beginProduce())
+            {
+                try
+                {
+                    input.read(chunk->bytes.data(), static_cast<std::streamsize>(chunk->bytes.size()));
+                    if (input.bad())
+                    {
+                        // a short read is the end of the input only if the stream did not fail
+                        throw std::runtime_error("Cannot read fraction stream");
+                    }
+                    chunk->size = static_cast<std::size_t>(input.gcount());
+                    chunk->last = chunk->size < chunk->bytes.size();
+                }
+                catch (...)
+                {
+                    failure = std::current_exception();
+                    chunk->size = 0;
+                    chunk->last = true;
+                }
+                bool last = chunk->last;
+                exchange.endProduce();
+                if (last)
+                {
+                    return;
+                }
+            }
+        }
+
+        /// append to the pending line, a line that outgrows FRACTION_LINE_MAX keeps only enough bytes to
+        /// be rejected by parseLine once its end arrives and the rest of it is dropped
+        void appendPending(const char *first, const char *last)
+        {
+            std::size_t room = FRACTION_LINE_MAX + 1 - pending.size();
+            pending.append(first, std::min(room, static_cast<std::size_t>(last - first)));
+        }
+
+        /// parse one complete line starting at byte offset of the input, true if it held a value
+        bool parseLine(const char *first, const char *last, std::size_t offset, Fraction &value)
+        {
+            ++lines;
+            FractionParseResult parsed = parse_fraction_line(first, last, value);
+            if (parsed.error != FractionParseError::none)
+            {
+                if (errors.size() < FRACTION_STREAM_MAX_ERRORS)
+                {
+                    errors.push_back(FractionLoadError{offset + parsed.consumed, lines, parsed.error});
+                }
+                ++errorCount;
+                return false;
+            }
+            return parsed.consumed != 0;
+        }
+    };
+
+    FractionStreamReader::FractionStreamReader(std::istream &input, std::size_t chunkBytes) : state(std::make_unique<State>(input, chunkBytes))
+    {
+    }
+
+    FractionStreamReader::~FractionStreamReader()
+    {
+        state->exchange.cancel();
+        state->io.join();
+    }
+
+    std::size_t FractionStreamReader::read(std::span<Fraction> values)
+    {
+        State &reader = *state;
+        std::size_t count = 0;
+        while (count < values.size() && !reader.finished)
+        {
+            if (reader.current == nullptr)
+            {
+                reader.current = reader.exchange.beginConsume();
+                reader.cursor = 0;
+                if (reader.failure)
+                {
+                    std::rethrow_exception(reader.failure);
+                }
+            }
+            Chunk &chunk = *reader.current;
+            const char *begin = chunk.bytes.data();
+            if (reader.cursor == chunk.size)
+            {
+                bool last = chunk.last;
+                reader.chunkOffset += chunk.size;
+                reader.current = nullptr;
+                reader.exchange.endConsume();
+                if (last)
+                {
+                    // a final line without a newline
+                    if (!reader.pending.empty() &&
+                        reader.parseLine(reader.pending.data(), reader.pending.data() + reader.pending.size(), reader.pendingOffset, values[count]))
+                    {
+                        ++count;
+                    }
+                    reader.pending.clear();
+                    reader.finished = true;
+                }
+                continue;
+            }
+            const char *lineStart = begin + reader.cursor;
+            const auto *newline = static_cast<const char *>(std::memchr(lineStart, '\n', chunk.size - reader.cursor));
+            if (newline == nullptr)
+            {
+                if (reader.pending.empty())
+                {
+                    reader.pendingOffset = reader.chunkOffset + reader.cursor;
+                }
+                reader.appendPending(lineStart, begin + chunk.size);
+                reader.cursor = chunk.size;
+                continue;
+            }
+            bool parsed = false;
+            if (reader.pending.empty())
+            {
+                parsed = reader.parseLine(lineStart, newline, reader.chunkOffset + reader.cursor, values[count]);
+            }
+            else
+            {
+                reader.appendPending(lineStart, newline);
+                parsed = reader.parseLine(reader.pending.data(), reader.pending.data() + reader.pending.size(), reader.pendingOffset, values[count]);
+                reader.pending.clear();
+            }
+            count += parsed ? 1 : 0;
+            reader.cursor = static_cast<std::size_t>(newline + 1 - begin);
+        }
+        return count;
+    }
+
+    std::size_t FractionStreamReader::errorCount() const
+    {
+        return state->errorCount;
+    }
+
+    const std::vector<FractionLoadError> &FractionStreamReader::errors() const
+    {
+        return state->errors;
+    }
+
+    struct FractionStreamWriter::State
+    {
+        std::ostream &output;
+        ChunkExchange exchange;
+        Chunk *current = nullptr;
+        bool finished = false;
+        std::thread io;
+
+        State(std::ostream &outputStream, std::size_t chunkBytes)
+            : output(outputStream), exchange(std::max(chunkBytes, FRACTION_CHARS_MAX + 1))
+        {
+            io = std::thread([this]()
+                             { writeLoop(); });
+        }
+
+        void writeLoop()
+        {
+            while (Chunk *chunk = exchange.beginConsume())
+            {
+                output.write(chunk->bytes.data(), static_cast<std::streamsize>(chunk->size));
+                bool last = chunk->last;
+                exchange.endConsume();
+                if (last)
+                {
+                    return;
+                }
+            }
+        }
+
+        /// hand the current chunk to the I/O thread
+        void publish(bool last)
+        {
+            if (current == nullptr)
+            {
+                current = exchange.beginProduce();
+                current->size = 0;
+            }
+            current->last = last;
+            current = nullptr;
+            exchange.endProduce();
+        }
+    };
+
+    FractionStreamWriter::FractionStreamWriter(std::ostream &output, std::size_t chunkBytes)
+        : state(std::make_unique<State>(output, chunkBytes))
+    {
+    }
+
+    FractionStreamWriter::~FractionStreamWriter()
+    {
+        if (!state->finished)
+        {
+            state->publish(true);
+            state->io.join();
+        }
+    }
+
+    void FractionStreamWriter::write(std::span<const Fraction> values)
+    {
+        State &writer = *state;
+        if (writer.finished)
+        {
+            throw std::logic_error("Fraction stream is already finished");
+        }
+        for (const Fraction &value : values)
+        {
+            if (writer.current != nullptr && writer.current->bytes.size() - writer.current->size < FRACTION_CHARS_MAX + 1)
+            {
+                writer.publish(false);
+            }
+            if (writer.current == nullptr)
+            {
+                writer.current = writer.exchange.beginProduce();
+                writer.current->size = 0;
+            }
+            Chunk &chunk = *writer.current;
+            char *end = chunk.bytes.data() + chunk.bytes.size();
+            char *position = to_chars(chunk.bytes.data() + chunk.size, end, value).ptr;
+            *position++ = '\n';
+            chunk.size = static_cast<std::size_t>(position - chunk.bytes.data());
+        }
+    }
+
+    void FractionStreamWriter::finish()
+    {
+        State &writer = *state;
+        if (writer.finished)
+        {
+            return;
+        }
+        writer.publish(true);
+        writer.io.join();
+        writer.finished = true;
+        writer.output.flush();
+        if (!writer.output)
+        {
+            throw std::runtime_error("Cannot write fraction stream");
+        }
+    }
+
+    FractionStreamStats process_fraction_stream(std::istream &input, std::ostream &output, const std::vector<FractionBatchTransform> &transforms,
+                                                std::size_t batchSize)
+    {
+        FractionStreamStats stats;
+        std::vector<Fraction> batch(std::max<std::size_t>(batchSize, 1));
+        FractionStreamReader reader(input);
+        FractionStreamWriter writer(output);
+        std::size_t count = 0;
+        while ((count = reader.read(batch)) != 0)
+        {
+            stats.valuesRead += count;
+            for (const FractionBatchTransform &transform : transforms)
+            {
+                count = std::min(count, transform(std::span<Fraction>(batch.data(), count)));
+            }
+            writer.write(std::span<const Fraction>(batch.data(), count));
+            stats.valuesWritten += count;
+        }
+        writer.finish();
+        stats.errors = reader.errorCount();
+        return stats;
+    }
+}
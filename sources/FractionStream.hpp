@@ -0,0 +1,113 @@
+#pragma once
+#include "Fraction.hpp"
+#include "FractionLoader.hpp"
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <vector>
+
+namespace ariel
+{
+    /// @brief default size of the I/O chunks of the stream reader and writer
+    const std::size_t FRACTION_STREAM_CHUNK = std::size_t(1) << 20;
+
+    /// @brief most errors kept by FractionStreamReader, later ones are only counted
+    const std::size_t FRACTION_STREAM_MAX_ERRORS = 1000;
+
+    /// @brief
+    /// Reads one fraction per line, in the format of load_fractions, from a file or pipe of any size.
+    /// A background thread reads the next fixed size chunk while the caller parses the current one,
+    /// and it blocks when both chunks are in use. Memory is bounded by two chunks plus FRACTION_LINE_MAX,
+    /// a longer line is rejected with FractionParseError::lineTooLong and the rest of it is skipped.
+    /// The stream must not be used by anyone else until the reader is destroyed.
+    class FractionStreamReader
+    {
+    private:
+        struct State;
+        std::unique_ptr<State> state;
+
+    public:
+        /// @brief constructor for a reader that starts reading in the background
+        /// @param input text stream, e.g. an ifstream or std::cin
+        /// @param chunkBytes bytes read per chunk
+        explicit FractionStreamReader(std::istream &input, std::size_t chunkBytes = FRACTION_STREAM_CHUNK);
+
+        FractionStreamReader(const FractionStreamReader &) = delete;
+        FractionStreamReader &operator=(const FractionStreamReader &) = delete;
+
+        /// @brief destructor for FractionStreamReader, stops the background thread. The thread checks for
+        /// the stop between reads but a read in progress cannot be interrupted, so destroying a reader of a
+        /// pipe before its end waits until the writer fills the current chunk or closes the pipe
+        ~FractionStreamReader();
+
+        /// @brief parse the next values into a reusable buffer
+        /// @param values output buffer
+        /// @return number of values parsed, less than values.size() only at the end of the input.
+        /// Lines that do not parse are skipped and recorded, an error of the underlying stream is rethrown
+        /// and a read that sets badbit throws runtime_error instead of ending the input early
+        std::size_t read(std::span<Fraction> values);
+
+        /// @brief number of lines rejected so far
+        std::size_t errorCount() const;
+
+        /// @brief the first FRACTION_STREAM_MAX_ERRORS rejected lines with their offset and line number
+        const std::vector<FractionLoadError> &errors() const;
+    };
+
+    /// @brief
+    /// Writes fractions as "n/d" lines. Values are formatted into one chunk while a background thread
+    /// writes the previous one to the stream; a caller that outpaces the stream blocks until a chunk is free.
+    class FractionStreamWriter
+    {
+    private:
+        struct State;
+        std::unique_ptr<State> state;
+
+    public:
+        /// @brief constructor for a writer that writes in the background
+        /// @param output text stream, e.g. an ofstream or std::cout
+        /// @param chunkBytes bytes handed to the stream per write
+        explicit FractionStreamWriter(std::ostream &output, std::size_t chunkBytes = FRACTION_STREAM_CHUNK);
+
+        FractionStreamWriter(const FractionStreamWriter &) = delete;
+        FractionStreamWriter &operator=(const FractionStreamWriter &) = delete;
+
+        /// @brief destructor for FractionStreamWriter, finishes the output if finish was not called
+        ~FractionStreamWriter();
+
+        /// @brief append values, one per line
+        void write(std::span<const Fraction> values);
+
+        /// @brief write the remaining text and stop the background thread
+        /// throws runtime_error if the stream failed, further writes throw logic_error
+        void finish();
+    };
+
+    /// @brief
+    /// Transform applied in place to a batch of values. It returns how many values, moved to the front
+    /// of the batch, continue down the stream, so a transform can map, filter or both.
+    using FractionBatchTransform = std::function<std::size_t(std::span<Fraction>)>;
+
+    /// @brief counters of a process_fraction_stream run
+    struct FractionStreamStats
+    {
+        std::size_t valuesRead = 0;
+        std::size_t valuesWritten = 0;
+        std::size_t errors = 0;
+    };
+
+    /// @brief
+    /// Read fractions from input, pass each batch through the transforms in order and write what is left
+    /// to output. Reading, transforming and writing overlap, and memory stays bounded by one batch and two
+    /// chunks on each side, whatever the size of the input.
+    /// @param input text stream with one fraction per line
+    /// @param output text stream that receives the results
+    /// @param transforms batch transforms applied in order
+    /// @param batchSize values per batch
+    /// @return FractionStreamStats counts of values read, written and lines rejected
+    FractionStreamStats process_fraction_stream(std::istream &input, std::ostream &output, const std::vector<FractionBatchTransform> &transforms,
+                                                std::size_t batchSize = 4096);
+}
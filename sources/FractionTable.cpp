@@ -0,0 +1,183 @@
+#include "FractionTable.hpp"
+#include "FractionBinary.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace ariel
+{
+    namespace
+    {
+        const std::uint8_t TABLE_VERSION = 1;
+        const std::uint16_t SORTED_FLAG = 1;
+        const unsigned NARROW_BITS = 32;
+        const unsigned WIDE_BITS = 64;
+
+        /// on disk header, the elements start right after it with the alignment of LongFraction
+        struct TableHeader
+        {
+            std::array<char, 4> magic;
+            std::uint8_t version;
+            std::uint8_t width;
+            std::uint16_t flags;
+            std::uint32_t checksum;
+            std::uint32_t reserved;
+            std::uint64_t count;
+            std::uint64_t padding;
+        };
+
+        static_assert(sizeof(TableHeader) == 32 && sizeof(TableHeader) % alignof(LongFraction) == 0, "unexpected TableHeader layout");
+
+        const std::array<char, 4> TABLE_MAGIC{'F', 'R', 'T', 'B'};
+
+        std::size_t elementBytes(unsigned width)
+        {
+            return width == NARROW_BITS ? sizeof(FlatFraction) : sizeof(LongFraction);
+        }
+
+        template <typename Element>
+        void writeTable(const std::string &path, std::span<const Element> elements, unsigned width)
+        {
+            TableHeader header{};
+            header.magic = TABLE_MAGIC;
+            header.version = TABLE_VERSION;
+            header.width = static_cast<std::uint8_t>(width);
+            header.flags = std::is_sorted(elements.begin(), elements.end()) ? SORTED_FLAG : 0;
+            std::span<const unsigned char> bytes(reinterpret_cast<const unsigned char *>(elements.data()), elements.size_bytes());
+            header.checksum = crc32(bytes);
+            header.count = elements.size();
+            std::ofstream output(path, std::ios::binary | std::ios::trunc);
+            output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            output.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!output)
+            {
+                throw std::runtime_error("Cannot write " + path);
+            }
+        }
+
+        template <typename Element>
+        std::optional<std::size_t> findIn(std::span<const Element> elements, bool sorted, const Element &value)
+        {
+            auto found = sorted ? std::lower_bound(elements.begin(), elements.end(), value) : std::find(elements.begin(), elements.end(), value);
+            if (found == elements.end() || *found != value)
+            {
+                return std::nullopt;
+            }
+            return static_cast<std::size_t>(found - elements.begin());
+        }
+    }
+
+    FractionTable::FractionTable(const std::string &path) : file(path, MappedFile::Access::random)
+    {
+        if constexpr (std::endian::native != std::endian::little)
+        {
+            throw std::runtime_error("Fraction tables are little endian");
+        }
+        if (file.size() < sizeof(TableHeader))
+        {
+            throw std::runtime_error("Not a fraction table");
+        }
+        const auto *header = static_cast<const TableHeader *>(file.data());
+        if (header->magic != TABLE_MAGIC)
+        {
+            throw std::runtime_error("Not a fraction table");
+        }
+        if (header->version != TABLE_VERSION || (header->width != NARROW_BITS && header->width != WIDE_BITS))
+        {
+            throw std::runtime_error("Unsupported fraction table version");
+        }
+        if ((file.size() - sizeof(TableHeader)) / elementBytes(header->width) != header->count ||
+            (file.size() - sizeof(TableHeader)) % elementBytes(header->width) != 0)
+        {
+            throw std::runtime_error("Truncated fraction table");
+        }
+        elements = static_cast<const unsigned char *>(file.data()) + sizeof(TableHeader);
+        count = header->count;
+        componentBits = header->width;
+        isSorted = (header->flags & SORTED_FLAG) != 0;
+        checksum = header->checksum;
+    }
+
+    bool FractionTable::verify() const
+    {
+        return crc32(std::span<const unsigned char>(elements, count * elementBytes(componentBits))) == checksum;
+    }
+
+    std::span<const FlatFraction> FractionTable::flat() const
+    {
+        if (componentBits != NARROW_BITS)
+        {
+            throw std::logic_error("Fraction table has 64-bit components");
+        }
+        return std::span<const FlatFraction>(reinterpret_cast<const FlatFraction *>(elements), count);
+    }
+
+    std::span<const LongFraction> FractionTable::wide() const
+    {
+        if (componentBits != WIDE_BITS)
+        {
+            throw std::logic_error("Fraction table has 32-bit components");
+        }
+        return std::span<const LongFraction>(reinterpret_cast<const LongFraction *>(elements), count);
+    }
+
+    Fraction FractionTable::operator[](std::size_t index) const
+    {
+        if (index >= count)
+        {
+            throw std::out_of_range("Fraction table index out of range");
+        }
+        // the file is only checked as a whole by verify, so every element read is checked on its own,
+        // once here, before the unchecked conversion
+        if (componentBits == NARROW_BITS)
+        {
+            const FlatFraction &element = flat()[index];
+            if (!element.canonical())
+            {
+                throw std::runtime_error("Corrupt fraction table element");
+            }
+            return element.toFraction();
+        }
+        const LongFraction &element = wide()[index];
+        if (!element.canonical())
+        {
+            throw std::runtime_error("Corrupt fraction table element");
+        }
+        return element.toFraction();
+    }
+
+    std::optional<std::size_t> FractionTable::find(const Fraction &value) const
+    {
+        if (componentBits == NARROW_BITS)
+        {
+            return findIn(flat(), isSorted, FlatFraction(value));
+        }
+        return findIn(wide(), isSorted, LongFraction(value));
+    }
+
+    void write_fraction_table(const std::string &path, std::span<const Fraction> values, unsigned width)
+    {
+        if (width == NARROW_BITS)
+        {
+            std::vector<FlatFraction> elements(values.begin(), values.end());
+            writeTable(path, std::span<const FlatFraction>(elements), width);
+        }
+        else if (width == WIDE_BITS)
+        {
+            std::vector<LongFraction> elements(values.begin(), values.end());
+            writeTable(path, std::span<const LongFraction>(elements), width);
+        }
+        else
+        {
+            throw std::invalid_argument("Fraction table width must be 32 or 64");
+        }
+    }
+
+    void write_fraction_table(const std::string &path, std::span<const LongFraction> values)
+    {
+        writeTable(path, values, WIDE_BITS);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "Fraction.hpp"
+#include "MappedFile.hpp"
+#include "PackedFraction.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace ariel
+{
+    static_assert(std::is_trivially_copyable_v<FlatFraction> && std::is_trivially_copyable_v<LongFraction>,
+                  "mapped table elements must be trivially copyable");
+
+    /// @brief
+    /// Read only fraction table mapped straight from a file written by write_fraction_table.
+    /// The layout is a 32 byte header ("FRTB", version, component width, flags with a sorted bit,
+    /// CRC-32 of the elements, element count) followed by little endian FlatFraction (32-bit components)
+    /// or LongFraction (64-bit components) elements. Opening only checks the header, the elements are
+    /// viewed in place without deserialization and their pages are shared by every process using the file.
+    class FractionTable
+    {
+    private:
+        MappedFile file;
+        const unsigned char *elements = nullptr;
+        std::size_t count = 0;
+        unsigned componentBits = 0;
+        bool isSorted = false;
+        std::uint32_t checksum = 0;
+
+    public:
+        /// @brief map a table file
+        /// @param path table file, throws runtime_error if it cannot be mapped or its header is invalid
+        explicit FractionTable(const std::string &path);
+
+        /// @brief number of elements
+        std::size_t size() const
+        {
+            return count;
+        }
+
+        /// @brief component width of the elements, 32 or 64
+        unsigned width() const
+        {
+            return componentBits;
+        }
+
+        /// @brief true if the elements are in exact ascending order, find then uses binary search
+        bool sorted() const
+        {
+            return isSorted;
+        }
+
+        /// @brief recompute the checksum of the elements, reads the whole table
+        /// @return true if it matches the header
+        bool verify() const;
+
+        /// @brief the elements of a 32-bit table in place, throws logic_error for a 64-bit table.
+        /// They are not validated: check canonical() before toFraction, or use operator[]
+        std::span<const FlatFraction> flat() const;
+
+        /// @brief the elements of a 64-bit table in place, throws logic_error for a 32-bit table.
+        /// They are not validated, see flat
+        std::span<const LongFraction> wide() const;
+
+        /// @brief element as a Fraction, throws out_of_range for a bad index, runtime_error if the element
+        /// is not reduced with a positive denominator (a corrupt or foreign file) and overflow_error
+        /// if an element of a 64-bit table does not fit in a Fraction
+        Fraction operator[](std::size_t index) const;
+
+        /// @brief index of an element equal to value, binary search if the table is sorted
+        /// @return the index or nothing if the value is not in the table
+        std::optional<std::size_t> find(const Fraction &value) const;
+    };
+
+    /// @brief write a table that FractionTable can map
+    /// @param path file to create or replace, throws runtime_error if it cannot be written
+    /// @param values elements of the table
+    /// @param width component width 32 or 64, else throws invalid_argument
+    void write_fraction_table(const std::string &path, std::span<const Fraction> values, unsigned width = 32);
+
+    /// @brief write a table of 64-bit elements that FractionTable can map
+    void write_fraction_table(const std::string &path, std::span<const LongFraction> values);
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ariel
+{
+    /// @brief
+    /// Compile time generated gcd and reciprocal tables for fractions whose numerator magnitude and
+    /// denominator are both below Bound. Fraction::reduce uses them to replace std::gcd and the two
+    /// divisions by table lookups and multiplications. Bounds above 256 make clang need a larger
+    /// -fconstexpr-steps to generate the table.
+    /// @tparam Bound exclusive upper bound of the numerator magnitude and the denominator
+    template <unsigned Bound>
+    struct SmallFractionTables
+    {
+        static_assert(Bound > 1 && Bound <= 1024, "table bound must be in (1, 1024]");
+
+        using gcd_type = std::conditional_t<(Bound <= 256), std::uint8_t, std::uint16_t>;
+
+        /// @brief gcd(a, b) at index a * Bound + b, filled by column so gcd(a, b) = gcd(b, a % b) is already known
+        static constexpr std::array<gcd_type, std::size_t(Bound) * Bound> gcdTable = []()
+        {
+            std::array<gcd_type, std::size_t(Bound) * Bound> table{};
+            for (unsigned right = 0; right < Bound; ++right)
+            {
+                for (unsigned left = 0; left < Bound; ++left)
+                {
+                    table[std::size_t(left) * Bound + right] =
+                        right == 0 ? gcd_type(left) : table[std::size_t(right) * Bound + left % right];
+                }
+            }
+            return table;
+        }();
+
+        /// @brief ceil(2^32 / d), so that (n * reciprocal[d]) >> 32 == n / d for every n below Bound
+        static constexpr std::array<std::uint64_t, Bound> reciprocal = []()
+        {
+            std::array<std::uint64_t, Bound> table{};
+            for (unsigned divisor = 1; divisor < Bound; ++divisor)
+            {
+                table[divisor] = ((std::uint64_t(1) << 32) + divisor - 1) / divisor;
+            }
+            return table;
+        }();
+
+        /// @brief true if both components are inside the table range
+        static constexpr bool inRange(int numerator, int denominator)
+        {
+            return numerator > -int(Bound) && numerator < int(Bound) && denominator > 0 && denominator < int(Bound);
+        }
+
+        /// @brief reduce a fraction with a positive denominator through the tables
+        /// @return false without touching the components if they are outside the table range
+        static constexpr bool reduce(int &numerator, int &denominator)
+        {
+            if (!inRange(numerator, denominator))
+            {
+                return false;
+            }
+            auto magnitude = static_cast<unsigned>(numerator < 0 ? -numerator : numerator);
+            auto divisorIndex = static_cast<unsigned>(denominator);
+            unsigned divisor = gcdTable[std::size_t(magnitude) * Bound + divisorIndex];
+            if (divisor > 1)
+            {
+                auto reducedMagnitude = static_cast<int>((magnitude * reciprocal[divisor]) >> 32);
+                numerator = numerator < 0 ? -reducedMagnitude : reducedMagnitude;
+                denominator = static_cast<int>((divisorIndex * reciprocal[divisor]) >> 32);
+            }
+            return true;
+        }
+
+        /// @brief exact three way comparison of two in range fractions, the cross products cannot overflow int
+        static constexpr int compare(int leftNumerator, int leftDenominator, int rightNumerator, int rightDenominator)
+        {
+            int leftSide = leftNumerator * rightDenominator;
+            int rightSide = rightNumerator * leftDenominator;
+            return (leftSide > rightSide) - (leftSide < rightSide);
+        }
+    };
+
+    /// @brief the tables used by Fraction, numerators and denominators below 256
+    using DefaultSmallTables = SmallFractionTables<256>;
+}
@@ -0,0 +1,258 @@
+#pragma once
+#include "Fraction.hpp"
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace ariel
+{
+    /// @brief signed integer wide enough to hold any product of two Fraction components
+    using wide_int = __int128;
+
+    /// @brief unsigned counterpart of wide_int
+    using wide_uint = unsigned __int128;
+
+    /// @brief
+    /// Unreduced rational with 128-bit components, used as the intermediate type of
+    /// multi-step computations so that only the final result is reduced and range checked.
+    /// The denominator is always positive.
+    struct WideRational
+    {
+        wide_int numerator = 0;
+        wide_int denominator = 1;
+
+        /// @brief widen a Fraction without reducing it again
+        /// @param fraction Fraction object to widen
+        /// @return WideRational with the same components
+        static WideRational of(const Fraction &fraction)
+        {
+            return WideRational{fraction.numerator, fraction.denominator};
+        }
+
+        /// @brief absolute value of a wide integer as an unsigned value
+        static wide_uint magnitude(wide_int value)
+        {
+            return value < 0 ? wide_uint(0) - static_cast<wide_uint>(value) : static_cast<wide_uint>(value);
+        }
+
+        /// @brief greatest common divisor of two wide integers, 32 and 64-bit fast paths when both fit
+        /// @return the gcd as a non negative wide integer, 0 only if both values are 0
+        static wide_int gcd(wide_int left, wide_int right)
+        {
+            wide_uint first = magnitude(left);
+            wide_uint second = magnitude(right);
+            if (first <= std::numeric_limits<std::uint32_t>::max() && second <= std::numeric_limits<std::uint32_t>::max())
+            {
+                return std::gcd(static_cast<std::uint32_t>(first), static_cast<std::uint32_t>(second));
+            }
+            if (first <= std::numeric_limits<std::uint64_t>::max() && second <= std::numeric_limits<std::uint64_t>::max())
+            {
+                return static_cast<wide_int>(std::gcd(static_cast<std::uint64_t>(first), static_cast<std::uint64_t>(second)));
+            }
+            while (second != 0)
+            {
+                wide_uint rest = first % second;
+                first = second;
+                second = rest;
+            }
+            return static_cast<wide_int>(first);
+        }
+
+        /// @brief product of two wide integers, the overflow check is skipped when both fit in 64 bits
+        /// @return true if the product overflowed
+        static bool mulOverflow(wide_int left, wide_int right, wide_int *result)
+        {
+            if (fitsInt64(left) && fitsInt64(right))
+            {
+                *result = left * right;
+                return false;
+            }
+            return __builtin_mul_overflow(left, right, result);
+        }
+
+        /// @brief true if the value fits in a signed 64-bit integer
+        static bool fitsInt64(wide_int value)
+        {
+            return value >= std::numeric_limits<std::int64_t>::min() && value <= std::numeric_limits<std::int64_t>::max();
+        }
+
+        /// @brief divide both components by their gcd, using 64-bit division when both fit
+        void reduce()
+        {
+            wide_int divisor = gcd(numerator, denominator);
+            if (divisor <= 1)
+            {
+                return;
+            }
+            if (fitsInt64(numerator) && fitsInt64(denominator))
+            {
+                auto narrowDivisor = static_cast<std::int64_t>(divisor);
+                numerator = static_cast<std::int64_t>(numerator) / narrowDivisor;
+                denominator = static_cast<std::int64_t>(denominator) / narrowDivisor;
+                return;
+            }
+            numerator /= divisor;
+            denominator /= divisor;
+        }
+
+        /// @brief exact sum, reduces the operands only if the unreduced sum does not fit
+        /// @return the sum, throws overflow_error if even the reduced sum does not fit
+        static WideRational add(const WideRational &left, const WideRational &right)
+        {
+            WideRational result;
+            if (left.denominator == right.denominator)
+            {
+                result.denominator = left.denominator;
+                if (!__builtin_add_overflow(left.numerator, right.numerator, &result.numerator))
+                {
+                    return result;
+                }
+            }
+            else
+            {
+                wide_int leftPart = 0;
+                wide_int rightPart = 0;
+                if (!mulOverflow(left.numerator, right.denominator, &leftPart) &&
+                    !mulOverflow(right.numerator, left.denominator, &rightPart) &&
+                    !__builtin_add_overflow(leftPart, rightPart, &result.numerator) &&
+                    !mulOverflow(left.denominator, right.denominator, &result.denominator))
+                {
+                    return result;
+                }
+            }
+            return addReduced(left, right);
+        }
+
+        /// @brief slow path of add, sums the reduced operands over their least common denominator
+        [[gnu::noinline]] static WideRational addReduced(WideRational left, WideRational right)
+        {
+            left.reduce();
+            right.reduce();
+            WideRational result;
+            wide_int common = gcd(left.denominator, right.denominator);
+            wide_int leftScale = right.denominator / common;
+            wide_int rightScale = left.denominator / common;
+            wide_int leftPart = 0;
+            wide_int rightPart = 0;
+            if (mulOverflow(left.numerator, leftScale, &leftPart) ||
+                mulOverflow(right.numerator, rightScale, &rightPart) ||
+                __builtin_add_overflow(leftPart, rightPart, &result.numerator) ||
+                mulOverflow(left.denominator, leftScale, &result.denominator))
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            return result;
+        }
+
+        /// @brief add a term over the least common denominator, keeps long running sums small
+        /// without reducing their numerator, throws overflow_error if the reduced sum does not fit
+        /// @param term the value to add to this sum
+        void accumulate(const WideRational &term)
+        {
+            if (denominator == term.denominator)
+            {
+                wide_int sum = 0;
+                if (!__builtin_add_overflow(numerator, term.numerator, &sum))
+                {
+                    numerator = sum;
+                    return;
+                }
+            }
+            else
+            {
+                wide_int common = gcd(denominator, term.denominator);
+                wide_int scale = term.denominator / common;
+                wide_int termScale = denominator / common;
+                wide_int scaled = 0;
+                wide_int termScaled = 0;
+                wide_int sum = 0;
+                wide_int newDenominator = 0;
+                if (!mulOverflow(numerator, scale, &scaled) && !mulOverflow(term.numerator, termScale, &termScaled) &&
+                    !__builtin_add_overflow(scaled, termScaled, &sum) && !mulOverflow(denominator, scale, &newDenominator))
+                {
+                    numerator = sum;
+                    denominator = newDenominator;
+                    return;
+                }
+            }
+            *this = add(*this, term);
+        }
+
+        /// @brief exact difference, see add
+        static WideRational sub(const WideRational &left, const WideRational &right)
+        {
+            return add(left, WideRational{-right.numerator, right.denominator});
+        }
+
+        /// @brief exact product, cross reduces the operands only if the unreduced product does not fit
+        /// @return the product, throws overflow_error if even the cross reduced product does not fit
+        static WideRational mul(const WideRational &left, const WideRational &right)
+        {
+            WideRational result;
+            if (!mulOverflow(left.numerator, right.numerator, &result.numerator) &&
+                !mulOverflow(left.denominator, right.denominator, &result.denominator))
+            {
+                return result;
+            }
+            return mulReduced(left, right);
+        }
+
+        /// @brief slow path of mul, multiplies the cross reduced operands
+        [[gnu::noinline]] static WideRational mulReduced(const WideRational &left, const WideRational &right)
+        {
+            WideRational result;
+            wide_int firstGcd = gcd(left.numerator, right.denominator);
+            wide_int secondGcd = gcd(right.numerator, left.denominator);
+            firstGcd = firstGcd == 0 ? 1 : firstGcd;
+            secondGcd = secondGcd == 0 ? 1 : secondGcd;
+            if (mulOverflow(left.numerator / firstGcd, right.numerator / secondGcd, &result.numerator) ||
+                mulOverflow(left.denominator / secondGcd, right.denominator / firstGcd, &result.denominator))
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            return result;
+        }
+
+        /// @brief exact quotient, throws runtime_error if the right operand is 0
+        static WideRational div(const WideRational &left, const WideRational &right)
+        {
+            if (right.numerator == 0)
+            {
+                throw std::runtime_error("Cannot divide by zero");
+            }
+            WideRational reciprocal{right.denominator, right.numerator};
+            if (reciprocal.denominator < 0)
+            {
+                reciprocal.numerator = -reciprocal.numerator;
+                reciprocal.denominator = -reciprocal.denominator;
+            }
+            return mul(left, reciprocal);
+        }
+
+        /// @brief rebuild a Fraction from components that are known to be reduced with a positive
+        /// denominator, e.g. read back from a checksummed column, without validating or reducing them
+        static Fraction trusted(int numerator, int denominator)
+        {
+            return Fraction(Fraction::ReducedTag{}, numerator, denominator);
+        }
+
+        /// @brief reduce once and narrow to a Fraction
+        /// @return the reduced Fraction, throws overflow_error if a component does not fit in int
+        Fraction toFraction() const
+        {
+            WideRational result = *this;
+            result.reduce();
+            if (result.numerator > std::numeric_limits<int>::max() || result.numerator < std::numeric_limits<int>::min() ||
+                result.denominator > std::numeric_limits<int>::max())
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            if (result.numerator == 0)
+            {
+                result.denominator = 1;
+            }
+            return Fraction(Fraction::ReducedTag{}, static_cast<int>(result.numerator), static_cast<int>(result.denominator));
+        }
+    };
+}
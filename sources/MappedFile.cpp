@@ -0,0 +1,49 @@
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ariel
+{
+    MappedFile::MappedFile(const std::string &path, Access access)
+    {
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        struct stat status
+        {
+        };
+        if (::fstat(descriptor, &status) != 0)
+        {
+            ::close(descriptor);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        length = (std::size_t)status.st_size;
+        if (length != 0)
+        {
+            address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        }
+        ::close(descriptor);
+        if (address == MAP_FAILED)
+        {
+            address = nullptr;
+            throw std::runtime_error("Cannot map " + path);
+        }
+        if (address != nullptr)
+        {
+            ::madvise(address, length, access == Access::sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (address != nullptr)
+        {
+            ::munmap(address, length);
+        }
+    }
+}
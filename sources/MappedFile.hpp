@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ariel
+{
+    /// @brief read only mapping of a whole file, unmapped on destruction. Clean pages of the mapping
+    /// come from the page cache, so every process mapping the same file shares them.
+    class MappedFile
+    {
+    private:
+        void *address = nullptr;
+        std::size_t length = 0;
+
+    public:
+        /// @brief expected access pattern, passed on to the kernel as read ahead advice
+        enum class Access
+        {
+            sequential,
+            random
+        };
+
+        /// @brief map a file
+        /// @param path file to map, throws runtime_error if it cannot be opened or mapped
+        /// @param access expected access pattern
+        explicit MappedFile(const std::string &path, Access access);
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        ~MappedFile();
+
+        /// @brief start of the mapping, nullptr for an empty file
+        const void *data() const
+        {
+            return address;
+        }
+
+        /// @brief size of the file in bytes
+        std::size_t size() const
+        {
+            return length;
+        }
+
+        /// @brief the mapped bytes as text
+        std::string_view text() const
+        {
+            return address == nullptr ? std::string_view() : std::string_view(static_cast<const char *>(address), length);
+        }
+    };
+}
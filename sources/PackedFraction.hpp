@@ -0,0 +1,206 @@
+#pragma once
+#include "Fraction.hpp"
+#include "FractionWide.hpp"
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ariel
+{
+    /// @brief
+    /// Reduced fraction stored in two Int components, for tables whose values need fewer (CompactFraction)
+    /// or more (LongFraction) bits than Fraction. Arithmetic is computed exactly in a wider intermediate
+    /// and narrowed on store, throwing overflow_error if the reduced result does not fit in Int.
+    /// @tparam Int signed component type
+    template <typename Int>
+    class PackedFraction
+    {
+    public:
+        /// @brief intermediate type wide enough for the products of two components
+        using wide_type = std::conditional_t<(sizeof(Int) <= sizeof(std::int32_t)), std::int64_t, wide_int>;
+
+    private:
+        Int numerator;
+        Int denominator;
+
+        static wide_type gcdOf(wide_type left, wide_type right)
+        {
+            if constexpr (std::is_same_v<wide_type, wide_int>)
+            {
+                return WideRational::gcd(left, right);
+            }
+            else
+            {
+                return std::gcd(left, right);
+            }
+        }
+
+        /// @brief normalize the sign, reduce once and narrow, the common store path of every operation
+        static PackedFraction narrow(wide_type numeratorVal, wide_type denominatorVal)
+        {
+            if (denominatorVal == 0)
+            {
+                throw std::invalid_argument("Denominator cannot be zero");
+            }
+            if (denominatorVal < 0)
+            {
+                numeratorVal = -numeratorVal;
+                denominatorVal = -denominatorVal;
+            }
+            wide_type divisor = gcdOf(numeratorVal, denominatorVal);
+            numeratorVal /= divisor;
+            denominatorVal /= divisor;
+            if (numeratorVal > std::numeric_limits<Int>::max() || numeratorVal < std::numeric_limits<Int>::min() ||
+                denominatorVal > std::numeric_limits<Int>::max())
+            {
+                throw std::overflow_error("Overflow error");
+            }
+            PackedFraction result;
+            result.numerator = static_cast<Int>(numeratorVal);
+            result.denominator = static_cast<Int>(denominatorVal);
+            return result;
+        }
+
+    public:
+        /// @brief default constructor, value 0/1
+        PackedFraction() : numerator(0), denominator(1) {}
+
+        /// @brief constructor from components, reduces them. The components are taken wide so that values
+        /// outside Int are range checked instead of silently truncated
+        /// @param numeratorVal numerator
+        /// @param denominatorVal denominator, throws invalid_argument if it is 0
+        /// @throws overflow_error if a reduced component does not fit in Int
+        explicit PackedFraction(wide_type numeratorVal, wide_type denominatorVal = 1)
+        {
+            *this = narrow(numeratorVal, denominatorVal);
+        }
+
+        /// @brief checked narrowing from Fraction
+        /// @param fraction Fraction object to convert, throws overflow_error if a component does not fit in Int
+        explicit PackedFraction(const Fraction &fraction)
+        {
+            *this = narrow(fraction.getNumerator(), fraction.getDenominator());
+        }
+
+        /// @brief true if the Fraction can be stored without overflow
+        static bool fits(const Fraction &fraction)
+        {
+            return fraction.getNumerator() >= std::numeric_limits<Int>::min() && fraction.getNumerator() <= std::numeric_limits<Int>::max() &&
+                   fraction.getDenominator() <= std::numeric_limits<Int>::max();
+        }
+
+        /// @brief true if the components are reduced with a positive denominator. Always the case for values
+        /// built by this class, not necessarily for elements viewed in place from a file (FractionTable::flat),
+        /// which must pass this check before toFraction
+        bool canonical() const
+        {
+            return denominator > 0 && WideRational::gcd(numerator, denominator) == 1;
+        }
+
+        /// @brief conversion to Fraction without validating or reducing again, like WideRational::trusted:
+        /// the components are taken as canonical, the invariant of this class
+        /// @return the same value as a Fraction, throws overflow_error if a component of a wider Int does not fit
+        Fraction toFraction() const
+        {
+            if constexpr (sizeof(Int) > sizeof(int))
+            {
+                if (numerator < std::numeric_limits<int>::min() || numerator > std::numeric_limits<int>::max() ||
+                    denominator > std::numeric_limits<int>::max())
+                {
+                    throw std::overflow_error("Overflow error");
+                }
+            }
+            return WideRational::trusted(static_cast<int>(numerator), static_cast<int>(denominator));
+        }
+
+        /// @brief explicit conversion to Fraction, see toFraction
+        explicit operator Fraction() const
+        {
+            return toFraction();
+        }
+
+        /// @brief gives the numerator
+        Int getNumerator() const
+        {
+            return numerator;
+        }
+
+        /// @brief gives the denominator, always positive
+        Int getDenominator() const
+        {
+            return denominator;
+        }
+
+        PackedFraction &operator+=(const PackedFraction &right)
+        {
+            return *this = narrow(wide_type(numerator) * right.denominator + wide_type(right.numerator) * denominator,
+                                  wide_type(denominator) * right.denominator);
+        }
+
+        PackedFraction &operator-=(const PackedFraction &right)
+        {
+            return *this = narrow(wide_type(numerator) * right.denominator - wide_type(right.numerator) * denominator,
+                                  wide_type(denominator) * right.denominator);
+        }
+
+        PackedFraction &operator*=(const PackedFraction &right)
+        {
+            return *this = narrow(wide_type(numerator) * right.numerator, wide_type(denominator) * right.denominator);
+        }
+
+        /// @brief divide in place, throws runtime_error when dividing by 0
+        PackedFraction &operator/=(const PackedFraction &right)
+        {
+            if (right.numerator == 0)
+            {
+                throw std::runtime_error("Cannot divide by zero");
+            }
+            return *this = narrow(wide_type(numerator) * right.denominator, wide_type(denominator) * right.numerator);
+        }
+
+        friend PackedFraction operator+(PackedFraction left, const PackedFraction &right) { return left += right; }
+        friend PackedFraction operator-(PackedFraction left, const PackedFraction &right) { return left -= right; }
+        friend PackedFraction operator*(PackedFraction left, const PackedFraction &right) { return left *= right; }
+        friend PackedFraction operator/(PackedFraction left, const PackedFraction &right) { return left /= right; }
+
+        /// @brief exact equality, both sides are reduced so the components are compared
+        friend bool operator==(const PackedFraction &left, const PackedFraction &right)
+        {
+            return left.numerator == right.numerator && left.denominator == right.denominator;
+        }
+
+        friend bool operator!=(const PackedFraction &left, const PackedFraction &right) { return !(left == right); }
+
+        /// @brief exact ordering by cross multiplication
+        friend bool operator<(const PackedFraction &left, const PackedFraction &right)
+        {
+            return wide_type(left.numerator) * right.denominator < wide_type(right.numerator) * left.denominator;
+        }
+
+        friend bool operator>(const PackedFraction &left, const PackedFraction &right) { return right < left; }
+        friend bool operator<=(const PackedFraction &left, const PackedFraction &right) { return !(right < left); }
+        friend bool operator>=(const PackedFraction &left, const PackedFraction &right) { return !(left < right); }
+
+        /// @brief prints "numerator/denominator" like Fraction
+        friend std::ostream &operator<<(std::ostream &outputStream, const PackedFraction &fraction)
+        {
+            return outputStream << static_cast<long long>(fraction.numerator) << "/" << static_cast<long long>(fraction.denominator);
+        }
+    };
+
+    /// @brief 4 byte fraction with 16-bit components for memory bound tables
+    using CompactFraction = PackedFraction<std::int16_t>;
+
+    /// @brief 8 byte fraction with the components of Fraction, trivially copyable so it can live in mapped files
+    using FlatFraction = PackedFraction<std::int32_t>;
+
+    /// @brief 16 byte fraction with 64-bit components for values that overflow Fraction
+    using LongFraction = PackedFraction<std::int64_t>;
+
+    static_assert(sizeof(CompactFraction) == 4, "CompactFraction must stay 4 bytes");
+    static_assert(sizeof(FlatFraction) == 8, "FlatFraction must stay 8 bytes");
+    static_assert(sizeof(LongFraction) == 16, "LongFraction must stay 16 bytes");
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include "ConcurrentQueue.hpp"
+#include "Fraction.hpp"
+#include "FractionWide.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ariel
+{
+    /// @brief
+    /// One partial sum of a ShardedFractionSum. It sits alone on its cache line(s), so the thread that
+    /// owns it adds without touching memory any other thread writes. Only one thread may add to a
+    /// shard at a time.
+    class alignas(CACHE_LINE_SIZE) FractionShard
+    {
+    private:
+        WideRational sum;
+
+        friend class ShardedFractionSum;
+
+    public:
+        /// @brief add a value exactly, throws overflow_error only if the reduced partial sum exceeds 128 bits
+        void add(const Fraction &value)
+        {
+            sum.accumulate(WideRational::of(value));
+        }
+
+        /// @brief add every value of a batch, see add
+        void add(std::span<const Fraction> values)
+        {
+            WideRational local = sum;
+            for (const Fraction &value : values)
+            {
+                local.accumulate(WideRational::of(value));
+            }
+            sum = local;
+        }
+    };
+
+    /// @brief
+    /// Exact sum that many threads add to at once with no shared writes on the hot path. Each thread
+    /// takes its own shard and adds into its unreduced 128-bit partial sum. collect merges the shards
+    /// in index order and reduces once. Rational addition is exact, so the result does not depend on
+    /// how the additions interleaved or on which shard received which value.
+    class ShardedFractionSum
+    {
+    private:
+        std::vector<FractionShard> shards;
+
+    public:
+        /// @brief constructor for a sum with the given number of shards, one per hardware thread if 0
+        explicit ShardedFractionSum(std::size_t shardCount = 0)
+            : shards(shardCount != 0 ? shardCount : std::max<std::size_t>(1, std::thread::hardware_concurrency()))
+        {
+        }
+
+        /// @brief number of shards
+        std::size_t size() const
+        {
+            return shards.size();
+        }
+
+        /// @brief the shard a thread adds into, throws out_of_range if index is not below size()
+        FractionShard &shard(std::size_t index)
+        {
+            if (index >= shards.size())
+            {
+                throw std::out_of_range("Shard index out of range");
+            }
+            return shards[index];
+        }
+
+        /// @brief exact reduced total, must not run concurrently with additions
+        /// @return WideRational the total with 128-bit components, throws overflow_error if it does not fit
+        WideRational collectWide() const
+        {
+            WideRational total;
+            for (const FractionShard &partial : shards)
+            {
+                total.accumulate(partial.sum);
+            }
+            total.reduce();
+            if (total.numerator == 0)
+            {
+                total.denominator = 1;
+            }
+            return total;
+        }
+
+        /// @brief exact reduced total as a Fraction, see collectWide
+        /// @return Fraction the total, throws overflow_error if it does not fit in int
+        Fraction collect() const
+        {
+            return collectWide().toFraction();
+        }
+
+        /// @brief set every partial sum back to 0, must not run concurrently with additions
+        void reset()
+        {
+            for (FractionShard &partial : shards)
+            {
+                partial.sum = WideRational();
+            }
+        }
+    };
+}